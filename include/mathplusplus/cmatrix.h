@@ -0,0 +1,121 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <vector>
+#include <type_traits>
+#include "complex.h"
+#include "dmatrix.h"
+#include "parallel.h"
+
+namespace math {
+
+	template<typename T>
+	class cmatrix {
+		template<typename>
+		friend class cmatrix;
+	private:
+		dmatrix<T> r, i;
+	public:
+		MATHPLUSPLUS_API cmatrix();
+		MATHPLUSPLUS_API cmatrix(const size_t h, const size_t w);
+		template<typename U>
+		MATHPLUSPLUS_API cmatrix(const dmatrix<U>& re, const dmatrix<U>& im);
+		template<typename U>
+		MATHPLUSPLUS_API cmatrix(const dmatrix<complex<U>>& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t width() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline dmatrix<T>& real();
+		MATHPLUSPLUS_API [[nodiscard]] inline const dmatrix<T>& real() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline dmatrix<T>& imag();
+		MATHPLUSPLUS_API [[nodiscard]] inline const dmatrix<T>& imag() const;
+
+		MATHPLUSPLUS_API [[nodiscard]] const dmatrix<complex<T>> eval() const;
+		MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> conj() const;
+		MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> trans(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> herm(const execution pol = execution::seq) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto mul(const cmatrix<U>& x, const execution pol = execution::seq) const;
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void apply(const std::vector<complex<U>>& x, std::vector<complex<V>>& y, const execution pol = execution::seq) const;
+
+		MATHPLUSPLUS_API [[nodiscard]] const complex<T> operator()(const size_t& i, const size_t& j) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator==(const cmatrix<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator!=(const cmatrix<U>& x) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API cmatrix<T>& operator+=(const cmatrix<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API cmatrix<T>& operator-=(const cmatrix<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API cmatrix<T>& operator*=(const complex<U>& x);
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator+(const cmatrix<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator-(const cmatrix<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const cmatrix<U>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> operator*(const complex<T>& x) const;
+	};
+
+	template<typename T>
+	class cluPreconditioner {
+	private:
+		cmatrix<T> lu;
+		std::vector<size_t> perm;
+		bool odd;
+	public:
+		template<typename U>
+		MATHPLUSPLUS_API cluPreconditioner(const cmatrix<U>& a, const execution pol = execution::seq);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		MATHPLUSPLUS_API [[nodiscard]] const complex<T> det() const;
+		template<typename U>
+		MATHPLUSPLUS_API void apply(const std::vector<complex<U>>& r, std::vector<complex<U>>& z) const;
+	};
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<complex<T>> herm(const dmatrix<complex<T>>& a, const execution pol = execution::seq);
+}
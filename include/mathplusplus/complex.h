@@ -39,12 +39,23 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif // MATHPLUSPLUS_EXPORTS
 
 #include <iostream>
+#include <type_traits>
+#include <type_traits>
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include "basics.h"
 
 namespace math {
 
+	template<typename T>
+	class complex;
+
+	template<typename T>
+	struct isComplex : std::false_type {};
+
+	template<typename T>
+	struct isComplex<complex<T>> : std::true_type {};
+
 	template<typename T>
 	class complex {
 	public:
@@ -77,40 +88,40 @@ namespace math {
 		template<typename U>
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator>=(const complex<U>& x) const;
 
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator=(const U& x);
 		template<typename U>
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator=(const complex<U>& x);
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator+=(const U& x);
 		template<typename U>
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator+=(const complex<U>& x);
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator-=(const U& x);
 		template<typename U>
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator-=(const complex<U>& x);
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator*=(const U& x);
 		template<typename U>
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator*=(const complex<U>& x);
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator/=(const U& x);
 		template<typename U>
 		MATHPLUSPLUS_API constexpr inline complex<T>& operator/=(const complex<U>& x);
 
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator+(const U& x) const;
 		template<typename U>
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator+(const complex<U>& x) const;
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const U& x) const;
 		template<typename U>
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const complex<U>& x) const;
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const U& x) const;
 		template<typename U>
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const complex<U>& x) const;
-		template<typename U>
+		template<typename U> requires (!isComplex<U>::value)
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator/(const U& x) const;
 		template<typename U>
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator/(const complex<U>& x) const;
@@ -118,13 +129,13 @@ namespace math {
 		constexpr static const complex<T> i = complex<T>(0, 1);
 	};
 
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator+(const T& x, const complex<U>& y);
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const T& x, const complex<U>& y);
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const T& x, const complex<U>& y);
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator/(const T& x, const complex<U>& y);
 
 	template<typename T>
@@ -0,0 +1,189 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "basics.h"
+#include "matrix.h"
+#include "parallel.h"
+
+namespace math {
+
+	class dimension_mismatch : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API dimension_mismatch();
+	};
+
+	class non_square_matrix : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API non_square_matrix();
+	};
+
+	MATHPLUSPLUS_API void setStrassenCrossover(const size_t n);
+	MATHPLUSPLUS_API [[nodiscard]] const size_t strassenCrossover();
+
+	template<typename T>
+	class dmatrix {
+	protected:
+		size_t h, w;
+		std::vector<T> buf;
+	public:
+		MATHPLUSPLUS_API dmatrix();
+		MATHPLUSPLUS_API dmatrix(const size_t h, const size_t w);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix(const size_t h, const size_t w, const U& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix(const std::initializer_list<std::initializer_list<U>>& buff);
+		template<typename U, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+		MATHPLUSPLUS_API dmatrix(const matrix<U, _H, _W, _L>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix(const dmatrix<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix(const matrixView<U>& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t width() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline T* data();
+		MATHPLUSPLUS_API [[nodiscard]] inline const T* data() const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep = 1, const size_t cstep = 1);
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep = 1, const size_t cstep = 1) const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> row(const size_t i);
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> row(const size_t i) const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> col(const size_t j);
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> col(const size_t j) const;
+
+		MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> trans(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API dmatrix<T>& transpose(const execution pol = execution::seq);
+		MATHPLUSPLUS_API [[nodiscard]] inline const transView<dmatrix<T>> t() const;
+		template<typename F>
+		MATHPLUSPLUS_API [[nodiscard]] const auto map(F&& f, const execution pol = execution::seq) const;
+		template<typename U, typename F>
+		MATHPLUSPLUS_API [[nodiscard]] const auto zipMap(const dmatrix<U>& x, F&& f, const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T sum(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T min(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T max(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const auto norm(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T trace() const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto dot(const dmatrix<U>& x, const execution pol = execution::seq) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto mul(const dmatrix<U>& x, const execution pol = execution::seq) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto mul(const transView<dmatrix<U>>& x, const execution pol = execution::seq) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto strassen(const dmatrix<U>& x, const size_t leaf = strassenCrossover(), const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T det(const execution pol = execution::seq) const;
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void apply(const std::vector<U>& x, std::vector<V>& y, const execution pol = execution::seq) const;
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void applyTrans(const std::vector<U>& x, std::vector<V>& y, const execution pol = execution::seq) const;
+
+		MATHPLUSPLUS_API [[nodiscard]] inline T* operator[](const size_t& h);
+		MATHPLUSPLUS_API [[nodiscard]] inline const T* operator[](const size_t& h) const;
+		MATHPLUSPLUS_API [[nodiscard]] inline T& operator()(const size_t& i, const size_t& j);
+		MATHPLUSPLUS_API [[nodiscard]] inline const T& operator()(const size_t& i, const size_t& j) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator==(const dmatrix<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator!=(const dmatrix<U>& x) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator=(const dmatrix<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator+=(const dmatrix<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator-=(const dmatrix<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator=(const matrixView<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator+=(const matrixView<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator-=(const matrixView<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator*=(const U& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator*=(const dmatrix<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API dmatrix<T>& operator/=(const U& x);
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator+(const dmatrix<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator-(const dmatrix<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const U& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const dmatrix<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const transView<dmatrix<U>>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator/(const U& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator+(const matrixView<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator-(const matrixView<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const matrixView<U>& x) const;
+
+		MATHPLUSPLUS_API [[nodiscard]] static const dmatrix<T> idMatrix(const size_t n);
+	};
+
+	template<typename T>
+	struct isMatrixType<dmatrix<T>> : std::true_type {};
+
+	template<typename U, typename T> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const U& x, const dmatrix<T>& m);
+
+	template<typename T, typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const transView<dmatrix<T>>& x, const dmatrix<U>& m);
+
+	template<typename T>
+	struct cxType;
+
+	template<typename T>
+	struct cxType<dmatrix<T>> {
+		using type = dmatrix<typename cxType<T>::type>;
+		using base = dmatrix<typename cxType<T>::base>;
+	};
+}
@@ -0,0 +1,69 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "intx.h"
+#include "matrix.h"
+#include "dmatrix.h"
+#include "parallel.h"
+
+namespace math {
+
+	template<typename T>
+	struct exactSolution {
+		std::vector<T> num;
+		T den;
+	};
+
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto bareiss(M a, const execution pol = execution::seq);
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const exactSolution<T> bareissSolve(const dmatrix<T>& a, const std::vector<T>& b);
+
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] const uint32_t detMod(const M& a, const uint32_t p);
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto detCRT(const M& a, const execution pol = execution::seq);
+
+	template<typename T, typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<uint32_t> mulMod(const dmatrix<T>& a, const dmatrix<U>& b, const uint32_t p, const execution pol = execution::seq);
+}
@@ -0,0 +1,101 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace math {
+
+	class float16 {
+	private:
+		uint16_t bits;
+	public:
+		MATHPLUSPLUS_API constexpr float16();
+		MATHPLUSPLUS_API float16(const float x);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const float16 fromBits(const uint16_t b);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint16_t raw() const;
+
+		MATHPLUSPLUS_API operator float() const;
+
+		MATHPLUSPLUS_API float16& operator+=(const float x);
+		MATHPLUSPLUS_API float16& operator-=(const float x);
+		MATHPLUSPLUS_API float16& operator*=(const float x);
+		MATHPLUSPLUS_API float16& operator/=(const float x);
+	};
+
+	class bfloat16 {
+	private:
+		uint16_t bits;
+	public:
+		MATHPLUSPLUS_API constexpr bfloat16();
+		MATHPLUSPLUS_API bfloat16(const float x);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const bfloat16 fromBits(const uint16_t b);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint16_t raw() const;
+
+		MATHPLUSPLUS_API operator float() const;
+
+		MATHPLUSPLUS_API bfloat16& operator+=(const float x);
+		MATHPLUSPLUS_API bfloat16& operator-=(const float x);
+		MATHPLUSPLUS_API bfloat16& operator*=(const float x);
+		MATHPLUSPLUS_API bfloat16& operator/=(const float x);
+	};
+
+	MATHPLUSPLUS_API void toFloat(const float16* x, float* y, const size_t n);
+	MATHPLUSPLUS_API void toFloat(const bfloat16* x, float* y, const size_t n);
+	MATHPLUSPLUS_API void fromFloat(const float* x, float16* y, const size_t n);
+	MATHPLUSPLUS_API void fromFloat(const float* x, bfloat16* y, const size_t n);
+
+	template<typename T>
+	struct accumType {
+		using type = T;
+	};
+
+	template<>
+	struct accumType<float16> {
+		using type = float;
+	};
+
+	template<>
+	struct accumType<bfloat16> {
+		using type = float;
+	};
+}
@@ -40,6 +40,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <array>
 #include <iostream>
+#include <type_traits>
 
 namespace math {
 
@@ -235,6 +236,43 @@ namespace math {
 		MATHPLUSPLUS_API [[nodiscard]] explicit operator uint64_t() const;
 		MATHPLUSPLUS_API [[nodiscard]] explicit operator uint32_t() const;
 	};
+
+	template<typename T>
+	struct isWideInt : std::false_type {};
+	template<>
+	struct isWideInt<uint128_t> : std::true_type {};
+	template<>
+	struct isWideInt<uint256_t> : std::true_type {};
+	template<>
+	struct isWideInt<uint512_t> : std::true_type {};
+	template<>
+	struct isWideInt<uint1024_t> : std::true_type {};
+
+	template<typename T>
+	struct isExactType : std::bool_constant<std::is_integral_v<T> || isWideInt<T>::value> {};
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool isNegative(const T& x);
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T sdiv(const T& x, const T& y);
+
+	// Limb-wise arithmetic on the big-endian 32-bit limbs the wide integers are stored in; add and sub return the
+	// carry or borrow out of the top limb.
+	template<size_t _N>
+	MATHPLUSPLUS_API constexpr inline const uint32_t limbAdd(std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b);
+	template<size_t _N>
+	MATHPLUSPLUS_API constexpr inline const uint32_t limbSub(std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b);
+	template<size_t _N>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool limbLess(const std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b);
+
+	// b^e mod p for a modulus below 2^32, so that products of residues fit in 64 bits.
+	// Defined here because it is inline and every translation unit running a modular kernel calls it.
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint64_t powMod(uint64_t b, uint64_t e, const uint64_t p) {
+		uint64_t r = 1 % p;
+		for (b %= p; e; e >>= 1, b = b * b % p)
+			if (e & 1) r = r * b % p;
+		return r;
+	}
 }
 
 namespace std {
@@ -0,0 +1,197 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include "complex.h"
+#include "half.h"
+#include "matrix.h"
+#include "dmatrix.h"
+#include "sparse.h"
+#include "view.h"
+
+namespace math {
+
+	class matrix_file_error : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API matrix_file_error(const std::string& what);
+	};
+
+	enum class dtype : uint8_t {
+		raw,
+		f16,
+		bf16,
+		f32,
+		f64,
+		c64,
+		c128,
+		i8,
+		i16,
+		i32,
+		i64,
+		u8,
+		u16,
+		u32,
+		u64
+	};
+
+	// Element code stored in matrix files; trivially copyable types without a code are stored as raw bytes.
+	template<typename T>
+	struct dtypeOf : std::integral_constant<dtype, dtype::raw> {};
+	template<>
+	struct dtypeOf<float16> : std::integral_constant<dtype, dtype::f16> {};
+	template<>
+	struct dtypeOf<bfloat16> : std::integral_constant<dtype, dtype::bf16> {};
+	template<>
+	struct dtypeOf<float> : std::integral_constant<dtype, dtype::f32> {};
+	template<>
+	struct dtypeOf<double> : std::integral_constant<dtype, dtype::f64> {};
+	template<>
+	struct dtypeOf<complex<float>> : std::integral_constant<dtype, dtype::c64> {};
+	template<>
+	struct dtypeOf<complex<double>> : std::integral_constant<dtype, dtype::c128> {};
+	template<>
+	struct dtypeOf<int8_t> : std::integral_constant<dtype, dtype::i8> {};
+	template<>
+	struct dtypeOf<int16_t> : std::integral_constant<dtype, dtype::i16> {};
+	template<>
+	struct dtypeOf<int32_t> : std::integral_constant<dtype, dtype::i32> {};
+	template<>
+	struct dtypeOf<int64_t> : std::integral_constant<dtype, dtype::i64> {};
+	template<>
+	struct dtypeOf<uint8_t> : std::integral_constant<dtype, dtype::u8> {};
+	template<>
+	struct dtypeOf<uint16_t> : std::integral_constant<dtype, dtype::u16> {};
+	template<>
+	struct dtypeOf<uint32_t> : std::integral_constant<dtype, dtype::u32> {};
+	template<>
+	struct dtypeOf<uint64_t> : std::integral_constant<dtype, dtype::u64> {};
+
+	enum class storageKind : uint8_t {
+		dense,
+		coo,
+		csr,
+		csc
+	};
+
+	// Fixed 64-byte header at the start of every matrix file. Dense files store `lines` lines of `stride`
+	// elements at `offset`; sparse files store the outer indices, inner indices and values as consecutive
+	// sections, each starting on an `align` boundary, with indices as 64-bit integers.
+	struct matrixFileHeader {
+		char magic[4];
+		uint16_t version;
+		uint16_t order;
+		uint8_t type;
+		uint8_t kind;
+		uint8_t column;
+		uint8_t elemSize;
+		uint32_t align;
+		uint64_t height;
+		uint64_t width;
+		uint64_t stride;
+		uint64_t nnz;
+		uint64_t offset;
+		uint64_t reserved;
+
+		static constexpr uint16_t currentVersion = 1;
+	};
+	static_assert(sizeof(matrixFileHeader) == 64, "math::matrixFileHeader must be 64 bytes.");
+
+	// Read-only mapping of a whole file; the mapping is released with the object.
+	class mappedFile {
+	private:
+		const unsigned char* p;
+		size_t n;
+#ifdef _WIN32
+		void* file, * mapping;
+#endif
+	public:
+		MATHPLUSPLUS_API mappedFile();
+		MATHPLUSPLUS_API mappedFile(const std::string& path);
+		MATHPLUSPLUS_API mappedFile(mappedFile&& x) noexcept;
+		mappedFile(const mappedFile&) = delete;
+		MATHPLUSPLUS_API ~mappedFile();
+
+		MATHPLUSPLUS_API mappedFile& operator=(mappedFile&& x) noexcept;
+		mappedFile& operator=(const mappedFile&) = delete;
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const unsigned char* data() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t size() const;
+	};
+
+	template<typename T>
+	class mappedMatrix {
+	private:
+		mappedFile f;
+		matrixFileHeader hdr;
+		const T* p;
+	public:
+		MATHPLUSPLUS_API mappedMatrix(const std::string& path);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t width() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const matrixFileHeader& header() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const T* data() const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> view() const;
+		MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> eval() const;
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const T& operator()(const size_t& i, const size_t& j) const;
+	};
+
+	MATHPLUSPLUS_API [[nodiscard]] const matrixFileHeader readHeader(const std::string& path);
+
+	template<typename T>
+	MATHPLUSPLUS_API void save(const std::string& path, const dmatrix<T>& x);
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API void save(const std::string& path, const matrix<T, _H, _W, _L>& x);
+	template<typename T>
+	MATHPLUSPLUS_API void save(const std::string& path, const sparse_matrix<T>& x);
+
+	template<typename T>
+	MATHPLUSPLUS_API void load(const std::string& path, dmatrix<T>& x);
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API void load(const std::string& path, matrix<T, _H, _W, _L>& x);
+	template<typename T>
+	MATHPLUSPLUS_API void load(const std::string& path, sparse_matrix<T>& x);
+}
@@ -0,0 +1,103 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "dmatrix.h"
+
+namespace math {
+
+	class not_positive_definite : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API not_positive_definite();
+	};
+
+	template<typename T>
+	class matrixWorkspace {
+	private:
+		size_t n;
+		std::vector<T> buf;
+	public:
+		MATHPLUSPLUS_API matrixWorkspace(const size_t n = 0);
+
+		MATHPLUSPLUS_API void reserve(const size_t n);
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t size() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline T* slot(const size_t k);
+	};
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> pow(const sqMatrix<T, _N, _L>& a, const uint64_t e);
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> pow(const sqMatrix<T, _N, _L>& a, const uint64_t e, matrixWorkspace<T>& ws);
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> pow(const dmatrix<T>& a, const uint64_t e);
+	template<typename T>
+	MATHPLUSPLUS_API void pow(const dmatrix<T>& a, const uint64_t e, dmatrix<T>& res, matrixWorkspace<T>& ws);
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> expm(const sqMatrix<T, _N, _L>& a);
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> expm(const sqMatrix<T, _N, _L>& a, matrixWorkspace<T>& ws);
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> expm(const dmatrix<T>& a);
+	template<typename T>
+	MATHPLUSPLUS_API void expm(const dmatrix<T>& a, dmatrix<T>& res, matrixWorkspace<T>& ws);
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> sqrtm(const sqMatrix<T, _N, _L>& a);
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> sqrtm(const sqMatrix<T, _N, _L>& a, matrixWorkspace<T>& ws);
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> sqrtm(const dmatrix<T>& a);
+	template<typename T>
+	MATHPLUSPLUS_API void sqrtm(const dmatrix<T>& a, dmatrix<T>& res, matrixWorkspace<T>& ws);
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> logm(const sqMatrix<T, _N, _L>& a);
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> logm(const sqMatrix<T, _N, _L>& a, matrixWorkspace<T>& ws);
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> logm(const dmatrix<T>& a);
+	template<typename T>
+	MATHPLUSPLUS_API void logm(const dmatrix<T>& a, dmatrix<T>& res, matrixWorkspace<T>& ws);
+}
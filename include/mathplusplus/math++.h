@@ -35,7 +35,18 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "basics.h"
 #include "trig.h"
 #include "intx.h"
+#include "modint.h"
 #include "complex.h"
+#include "half.h"
+#include "parallel.h"
 #include "matrix.h"
+#include "dmatrix.h"
+#include "cmatrix.h"
+#include "sparse.h"
+#include "solver.h"
+#include "view.h"
+#include "io.h"
+#include "matfun.h"
+#include "exact.h"
 #include "vec2.h"
 #include "vec3.h"
\ No newline at end of file
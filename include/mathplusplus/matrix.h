@@ -39,119 +39,259 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif // MATHPLUSPLUS_EXPORTS
 
 #include <stdint.h>
+#include <stddef.h>
 #include <array>
 #include <vector>
 #include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "half.h"
+#include "parallel.h"
 
 #ifndef _MX_SIZE_T_
-#define _MX_SIZE_T_ uint8_t
+#define _MX_SIZE_T_ size_t
 #endif // !_MX_SIZE_T_
 
+#ifndef _MX_SIMD_WIDTH_
+#if defined(__AVX512F__)
+#define _MX_SIMD_WIDTH_ 64
+#elif defined(__AVX__)
+#define _MX_SIMD_WIDTH_ 32
+#else
+#define _MX_SIMD_WIDTH_ 16
+#endif
+#endif // !_MX_SIMD_WIDTH_
+
 namespace math {
 
-	template<typename T, _MX_SIZE_T_ _N>
+	class singular_matrix : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API singular_matrix();
+	};
+
+	// Storage policy of math::matrix: _Column stores columns contiguously, _Align aligns the
+	// whole buffer and _Pad rounds every stored line up to a multiple of _Pad bytes (zero-filled).
+	template<bool _Column, size_t _Align = 0, size_t _Pad = 0>
+	struct layout {
+		static constexpr bool column = _Column;
+		static constexpr size_t align = _Align;
+		static constexpr size_t pad = _Pad;
+	};
+
+	using rowMajor = layout<false>;
+	using colMajor = layout<true>;
+	using padded = layout<false, _MX_SIMD_WIDTH_, _MX_SIMD_WIDTH_>;
+	template<size_t _A = 64>
+	using aligned = layout<false, _A, _A>;
+
+	template<typename S>
+	class strideRef {
+	private:
+		S* s;
+		size_t i;
+	public:
+		MATHPLUSPLUS_API constexpr strideRef(S* s, const size_t i);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline auto& operator[](const size_t& j) const;
+	};
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L = rowMajor>
 	class sqMatrix;
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
+	template<typename M>
+	class transView;
+
+	template<typename T>
+	class matrixView;
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L = rowMajor>
+	class matrix;
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	std::true_type isMatrixBase(const matrix<T, _H, _W, _L>*);
+	std::false_type isMatrixBase(...);
+
+	template<typename T>
+	struct isMatrixType : decltype(isMatrixBase(std::declval<T*>())) {};
+
+	template<typename M>
+	struct isMatrixType<transView<M>> : std::true_type {};
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
 	class matrix {
 		static_assert(_H > 0, "Height of math::matrix must be non-zero.");
 		static_assert(_W > 0, "Width of math::matrix must benon-zero.");
+		template<typename, _MX_SIZE_T_, _MX_SIZE_T_, typename>
+		friend class matrix;
+	public:
+		using policy = _L;
+		static constexpr size_t lines = _L::column ? _W : _H;
+		static constexpr size_t length = _L::column ? _H : _W;
+		// Lanes past length are padding and stay zero: element-wise operators may run over them, scalar ones must not.
+		static constexpr size_t stride = _L::pad > sizeof(T) && _L::pad % sizeof(T) == 0 ? (length * sizeof(T) + _L::pad - 1) / _L::pad * (_L::pad / sizeof(T)) : length;
+		using storage = std::array<std::array<T, stride>, lines>;
+		using reference = std::conditional_t<_L::column, strideRef<storage>, std::array<T, stride>&>;
+		using const_reference = std::conditional_t<_L::column, strideRef<const storage>, const std::array<T, stride>&>;
 	protected:
-		std::array<std::array<T, _W>, _H> buf;
+		alignas(_L::align > alignof(storage) ? _L::align : alignof(storage)) storage buf{};
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& at(const size_t& i, const size_t& j);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& at(const size_t& i, const size_t& j) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& elem(const size_t& k) const;
 	public:
 		MATHPLUSPLUS_API constexpr matrix();
 		template<typename U>
 		MATHPLUSPLUS_API constexpr matrix(const std::array<std::array<U, _W>, _H>& buff);
 		template<typename U>
 		MATHPLUSPLUS_API constexpr matrix(const std::initializer_list<std::initializer_list<U>>& buff);
-		template<typename U>
-		MATHPLUSPLUS_API constexpr matrix(const matrix<U, _H, _W>& x);
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API constexpr matrix(const matrix<U, _H, _W, _M>& x);
 
-		template<typename U>
-		MATHPLUSPLUS_API matrix<T, _H, _W>& mask(matrix<U, _H, _W> x);
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API matrix<T, _H, _W, _L>& mask(const matrix<U, _H, _W, _M>& x);
 
-		MATHPLUSPLUS_API [[nodiscard]] const matrix<T, _W, _H> trans() const;
-		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] const auto masked(matrix<U, _H, _W> x) const;
-		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] const matrix<U, _H, _W> map(U(*f)()) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const _MX_SIZE_T_ height();
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const _MX_SIZE_T_ width();
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const matrix<T, _W, _H, _L> trans() const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const transView<matrix<T, _H, _W, _L>> t() const;
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] const auto masked(const matrix<U, _H, _W, _M>& x) const;
+		template<typename F>
+		MATHPLUSPLUS_API [[nodiscard]] const auto map(F&& f, const execution pol = execution::seq) const;
+		template<typename U, typename _M, typename F>
+		MATHPLUSPLUS_API [[nodiscard]] const auto zipMap(const matrix<U, _H, _W, _M>& x, F&& f, const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T sum(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T min(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T max(const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const auto norm(const execution pol = execution::seq) const;
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] const auto dot(const matrix<U, _H, _W, _M>& x, const execution pol = execution::seq) const;
+		template<typename U, _MX_SIZE_T_ _V, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] const auto mul(const matrix<U, _W, _V, _M>& x, const execution pol) const;
 
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator begin();
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator end();
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator rbegin();
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator rend();
+		MATHPLUSPLUS_API [[nodiscard]] inline T* data();
+		MATHPLUSPLUS_API [[nodiscard]] inline const T* data() const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep = 1, const size_t cstep = 1);
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep = 1, const size_t cstep = 1) const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> row(const size_t i);
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> row(const size_t i) const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> col(const size_t j);
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> col(const size_t j) const;
+		template<_MX_SIZE_T_ _R, _MX_SIZE_T_ _C>
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> block(const size_t i, const size_t j);
+		template<_MX_SIZE_T_ _R, _MX_SIZE_T_ _C>
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> block(const size_t i, const size_t j) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline std::array<T, stride>& line(const size_t& l);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const std::array<T, stride>& line(const size_t& l) const;
 
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator begin() const;
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator end() const;
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator rbegin() const;
-		MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator rend() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::iterator begin();
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::iterator end();
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::iterator rbegin();
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::iterator rend();
 
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline std::array<T, _W>& operator[](const _MX_SIZE_T_& h);
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const std::array<T, _W>& operator[](const _MX_SIZE_T_& h) const;
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::const_iterator begin() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::const_iterator end() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::const_iterator rbegin() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline typename storage::const_iterator rend() const;
 
-		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator==(const matrix<U, _H, _W>& x) const;
-		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator!=(const matrix<U, _H, _W>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline reference operator[](const _MX_SIZE_T_& h);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const_reference operator[](const _MX_SIZE_T_& h) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& operator()(const _MX_SIZE_T_& i, const _MX_SIZE_T_& j);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& operator()(const _MX_SIZE_T_& i, const _MX_SIZE_T_& j) const;
 
-		template<typename U>
-		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& operator=(const matrix<U, _H, _W>& x);
-		template<typename U>
-		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& operator+=(const matrix<U, _H, _W>& x);
-		template<typename U>
-		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& operator-=(const matrix<U, _H, _W>& x);
-		template<typename U>
-		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& operator*=(const U& x);
-		template<typename U>
-		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& operator*=(const sqMatrix<U, _W>& x);
-		template<typename U>
-		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& operator/=(const U& x);
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator==(const matrix<U, _H, _W, _M>& x) const;
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator!=(const matrix<U, _H, _W, _M>& x) const;
 
-		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline  const auto operator+(const matrix<U, _H, _W>& x) const;
-		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const matrix<U, _H, _W>& x) const;
-		template<typename U>
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& operator=(const matrix<U, _H, _W, _M>& x);
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& operator+=(const matrix<U, _H, _W, _M>& x);
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& operator-=(const matrix<U, _H, _W, _M>& x);
+		template<typename U> requires (!isMatrixType<U>::value)
+		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& operator*=(const U& x);
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& operator*=(const sqMatrix<U, _W, _M>& x);
+		template<typename U> requires (!isMatrixType<U>::value)
+		MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& operator/=(const U& x);
+
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline  const auto operator+(const matrix<U, _H, _W, _M>& x) const;
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const matrix<U, _H, _W, _M>& x) const;
+		template<typename U> requires (!isMatrixType<U>::value)
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const U& x) const;
-		template<typename U, _MX_SIZE_T_ _V>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const matrix<U, _W, _V>& x) const;
-		template<typename U>
+		template<typename U, _MX_SIZE_T_ _V, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const matrix<U, _W, _V, _M>& x) const;
+		template<typename U, _MX_SIZE_T_ _V, typename _M>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const transView<matrix<U, _V, _W, _M>>& x) const;
+		template<typename U> requires (!isMatrixType<U>::value)
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator/(const U& x) const;
 	};
 
-	template<typename U, typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const U& x, const matrix<T, _H, _W>& m);
+	template<typename U, typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const U& x, const matrix<T, _H, _W, _L>& m);
+
+	template<typename M>
+	class transView {
+	private:
+		const M* m;
+	public:
+		MATHPLUSPLUS_API constexpr explicit transView(const M& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const M& base() const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const size_t height() const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const size_t width() const;
+		MATHPLUSPLUS_API [[nodiscard]] const auto eval() const;
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void apply(const std::vector<U>& x, std::vector<V>& y, const execution pol = execution::seq) const;
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator()(const size_t& i, const size_t& j) const;
+	};
+
+	template<typename T>
+	MATHPLUSPLUS_API void transKernel(const T* a, const size_t lda, T* b, const size_t ldb, const size_t r, const size_t c);
+
+	template<typename T>
+	MATHPLUSPLUS_API void transInPlace(T* a, const size_t lda, const size_t n, const execution pol = execution::seq);
 
 	template<typename T>
 	struct cxType;
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	struct cxType<matrix<T, _H, _W>> {
-		using type = matrix<typename cxType<T>::type, _H, _W>;
-		using base = matrix<typename cxType<T>::base, _H, _W>;
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	struct cxType<matrix<T, _H, _W, _L>> {
+		using type = matrix<typename cxType<T>::type, _H, _W, _L>;
+		using base = matrix<typename cxType<T>::base, _H, _W, _L>;
 	};
 
-	template<typename T, _MX_SIZE_T_ _N>
-	class sqMatrix : public matrix<T, _N, _N> {
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	class sqMatrix : public matrix<T, _N, _N, _L> {
 	public:
 		MATHPLUSPLUS_API constexpr sqMatrix();
 		template<typename U>
 		MATHPLUSPLUS_API constexpr sqMatrix(const std::array<std::array<U, _N>, _N>& buff);
 		template<typename U>
 		MATHPLUSPLUS_API constexpr sqMatrix(const std::initializer_list<std::initializer_list<U>>& buff);
-		template<typename U>
-		MATHPLUSPLUS_API constexpr sqMatrix(const sqMatrix<U, _N>& x);
+		template<typename U, typename _M>
+		MATHPLUSPLUS_API constexpr sqMatrix(const sqMatrix<U, _N, _M>& x);
 
-		MATHPLUSPLUS_API constexpr inline const sqMatrix<T, _N> trans();
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const sqMatrix<T, _N, _L> trans() const;
+		MATHPLUSPLUS_API constexpr inline sqMatrix<T, _N, _L>& transpose();
 
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T det() const;
+		MATHPLUSPLUS_API [[nodiscard]] const T det(const execution pol) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const sqMatrix<T, _N, _L> inv() const;
+		MATHPLUSPLUS_API [[nodiscard]] const T trace() const;
 
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const sqMatrix<T, _N> idMatrix();
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const sqMatrix<T, _N, _L> idMatrix();
 	};
 
-	template<typename T, _MX_SIZE_T_ _N>
-	struct cxType<sqMatrix<T, _N>> {
-		using type = sqMatrix<typename cxType<T>::type, _N>;
-		using base = sqMatrix<typename cxType<T>::base, _N>;
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	struct cxType<sqMatrix<T, _N, _L>> {
+		using type = sqMatrix<typename cxType<T>::type, _N, _L>;
+		using base = sqMatrix<typename cxType<T>::base, _N, _L>;
 	};
 }
\ No newline at end of file
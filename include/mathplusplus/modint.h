@@ -0,0 +1,162 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include "intx.h"
+
+namespace math {
+
+	class invalid_modulus : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API invalid_modulus();
+	};
+
+	// Residues modulo an odd _P below 2^31, held in Montgomery form x 2^32 mod _P so that a product costs two
+	// multiplications and a shift instead of a 64-bit division. Division assumes _P is prime.
+	template<uint32_t _P>
+	class modint {
+		static_assert(_P % 2 == 1 && _P > 2 && _P < (1u << 31), "math::modint needs an odd modulus between 2 and 2^31");
+	private:
+		uint32_t v;
+		// -_P^-1 mod 2^32 by Newton's iteration, and 2^64 mod _P for converting into Montgomery form
+		static constexpr uint32_t nInv = [] {
+			uint32_t x = _P;
+			for (int i = 0; i < 4; i++)
+				x *= 2 - _P * x;
+			return 0u - x;
+		}();
+		static constexpr uint32_t r2 = (uint32_t)((0 - (uint64_t)_P) % _P);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const uint32_t reduce(const uint64_t t);
+	public:
+		MATHPLUSPLUS_API constexpr modint();
+		template<typename I> requires std::is_integral_v<I>
+		MATHPLUSPLUS_API constexpr modint(const I x);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const uint32_t modulus();
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint32_t value() const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> pow(uint64_t e) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> inv() const;
+
+		MATHPLUSPLUS_API [[nodiscard]] explicit constexpr operator uint32_t() const;
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator==(const modint<_P>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator!=(const modint<_P>& x) const;
+
+		MATHPLUSPLUS_API constexpr inline modint<_P>& operator+=(const modint<_P>& x);
+		MATHPLUSPLUS_API constexpr inline modint<_P>& operator-=(const modint<_P>& x);
+		MATHPLUSPLUS_API constexpr inline modint<_P>& operator*=(const modint<_P>& x);
+		MATHPLUSPLUS_API constexpr inline modint<_P>& operator/=(const modint<_P>& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> operator-() const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> operator+(const modint<_P>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> operator-(const modint<_P>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> operator*(const modint<_P>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> operator/(const modint<_P>& x) const;
+	};
+
+	// Residues modulo an odd 256-bit modulus chosen at run time through setModulus(), one modulus per tag _I.
+	// Values are kept in Montgomery form over big-endian 32-bit limbs, as in uint256_t, and multiplied with the
+	// CIOS method; the modulus must be prime for division. setModulus() throws invalid_modulus for an even n or n = 1.
+	template<size_t _I = 0>
+	class modint256 {
+	private:
+		struct context {
+			uint256_t modulus;
+			std::array<uint32_t, 8> n, r2, one;
+			uint32_t nInv;
+		};
+		static context ctx;
+		std::array<uint32_t, 8> v;
+
+		MATHPLUSPLUS_API static void montMul(const std::array<uint32_t, 8>& a, const std::array<uint32_t, 8>& b, std::array<uint32_t, 8>& out);
+		MATHPLUSPLUS_API [[nodiscard]] static const std::array<uint32_t, 8> limbs(const uint256_t& x);
+		MATHPLUSPLUS_API [[nodiscard]] static const uint256_t join(const std::array<uint32_t, 8>& x);
+	public:
+		MATHPLUSPLUS_API static void setModulus(const uint256_t& n);
+		MATHPLUSPLUS_API [[nodiscard]] static const uint256_t modulus();
+
+		MATHPLUSPLUS_API modint256();
+		template<typename I> requires std::is_integral_v<I>
+		MATHPLUSPLUS_API modint256(const I x);
+		MATHPLUSPLUS_API modint256(const uint256_t& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] const uint256_t value() const;
+		MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> pow(const uint256_t& e) const;
+		MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> inv() const;
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const bool operator==(const modint256<_I>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const bool operator!=(const modint256<_I>& x) const;
+
+		MATHPLUSPLUS_API modint256<_I>& operator+=(const modint256<_I>& x);
+		MATHPLUSPLUS_API modint256<_I>& operator-=(const modint256<_I>& x);
+		MATHPLUSPLUS_API modint256<_I>& operator*=(const modint256<_I>& x);
+		MATHPLUSPLUS_API modint256<_I>& operator/=(const modint256<_I>& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> operator-() const;
+		MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> operator+(const modint256<_I>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> operator-(const modint256<_I>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> operator*(const modint256<_I>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> operator/(const modint256<_I>& x) const;
+	};
+
+	template<typename T>
+	struct isModint : std::false_type {};
+	template<uint32_t _P>
+	struct isModint<modint<_P>> : std::true_type {};
+
+	template<typename T>
+	struct cxType;
+
+	template<uint32_t _P>
+	struct cxType<modint<_P>> {
+		using type = modint<_P>;
+		using base = modint<_P>;
+	};
+	template<size_t _I>
+	struct cxType<modint256<_I>> {
+		using type = modint256<_I>;
+		using base = modint256<_I>;
+	};
+}
@@ -0,0 +1,127 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace math {
+
+	class busy_thread_pool : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API busy_thread_pool();
+	};
+
+	enum class execution {
+		seq,
+		par,
+		par_unseq
+	};
+
+	class threadPool {
+	private:
+		struct queue {
+			std::deque<std::function<void()>> tasks;
+			std::mutex m;
+		};
+
+		std::vector<std::unique_ptr<queue>> queues;
+		std::vector<std::thread> workers;
+		std::atomic<bool> stop;
+		std::atomic<size_t> pending, next;
+		std::mutex sleepMutex;
+		std::condition_variable sleep;
+		std::mutex regionMutex;
+		std::condition_variable regionIdle;
+		size_t regions;
+		bool resizing;
+
+		MATHPLUSPLUS_API void run(const size_t id);
+		MATHPLUSPLUS_API [[nodiscard]] const bool take(const size_t id, std::function<void()>& task);
+		MATHPLUSPLUS_API void start(const size_t n);
+		MATHPLUSPLUS_API void shutdown();
+	public:
+		// Held for the duration of a parallel region so resize() cannot replace the workers underneath it.
+		class region {
+		private:
+			threadPool& pool;
+			bool owner;
+		public:
+			MATHPLUSPLUS_API explicit region(threadPool& p);
+			MATHPLUSPLUS_API ~region();
+			region(const region&) = delete;
+			region& operator=(const region&) = delete;
+		};
+
+		MATHPLUSPLUS_API explicit threadPool(const size_t n = 0);
+		MATHPLUSPLUS_API ~threadPool();
+		threadPool(const threadPool&) = delete;
+		threadPool& operator=(const threadPool&) = delete;
+
+		MATHPLUSPLUS_API void resize(const size_t n);
+		MATHPLUSPLUS_API [[nodiscard]] const size_t size() const;
+		MATHPLUSPLUS_API void submit(std::function<void()> task);
+		MATHPLUSPLUS_API const bool runPending();
+
+		MATHPLUSPLUS_API [[nodiscard]] static threadPool& global();
+	};
+
+	MATHPLUSPLUS_API void setThreadCount(const size_t n);
+	MATHPLUSPLUS_API [[nodiscard]] const size_t threadCount();
+
+	template<typename F>
+	MATHPLUSPLUS_API void parallelFor(const execution pol, const size_t begin, const size_t end, const size_t grain, F&& f);
+
+	template<typename F>
+	MATHPLUSPLUS_API void parallelFor2d(const execution pol, const size_t rows, const size_t cols, const size_t tile, F&& f);
+
+	template<typename T, typename F>
+	MATHPLUSPLUS_API [[nodiscard]] const T pairwiseSum(const size_t begin, const size_t end, F&& f);
+
+	template<typename T, typename F, typename R>
+	MATHPLUSPLUS_API [[nodiscard]] const T parallelReduce(const execution pol, const size_t begin, const size_t end, const size_t grain, const T& init, F&& f, R&& op);
+}
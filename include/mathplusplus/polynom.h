@@ -38,19 +38,114 @@ POSSIBILITY OF SUCH DAMAGE.
 #define MATHPLUSPLUS_API _declspec(dllimport)
 #endif // MATHPLUSPLUS_EXPORTS
 
+#include <span>
 #include <vector>
+#include <unordered_map>
 #include <iostream>
 #include <exception>
+#include <stdexcept>
 #include <initializer_list>
 #include <array>
+#include <utility>
+#include <type_traits>
+#include <limits>
+#include <cmath>
+#include <stddef.h>
+#include <stdint.h>
 #include "complex.h"
+#include "modint.h"
+#include "parallel.h"
 
 #ifndef _MX_SIZE_T_
-#define _MX_SIZE_T_ uint8_t
+#define _MX_SIZE_T_ size_t
 #endif // !_MX_SIZE_T_
 
 namespace math {
 
+	class length_mismatch : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API length_mismatch();
+	};
+
+	class zero_divisor : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API zero_divisor();
+	};
+
+	class order_overflow : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API order_overflow();
+	};
+
+	class exponent_overflow : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API exponent_overflow();
+	};
+
+	enum class monomialOrder {
+		lex,
+		grlex,
+		grevlex
+	};
+
+	// Polynomials of order at or above this are evaluated with Estrin's scheme instead of Horner's rule.
+	constexpr _MX_SIZE_T_ estrinThreshold = 8;
+	// Products switch from the schoolbook loop to Karatsuba when the shorter factor reaches karatsubaThreshold
+	// coefficients, then to FFT for floating point at fftThreshold and to NTT for integers at nttThreshold.
+	constexpr _MX_SIZE_T_ karatsubaThreshold = 32;
+	constexpr _MX_SIZE_T_ fftThreshold = 256;
+	constexpr _MX_SIZE_T_ nttThreshold = 4096;
+	// Coefficients in modint<P> need no magnitude bound, so they move to NTT as soon as it beats Karatsuba.
+	constexpr _MX_SIZE_T_ modNttThreshold = 64;
+	// Over exact fields, division by a divisor and with a quotient both at least this long runs through a Newton
+	// power-series inverse. Floating-point and complex coefficients always use long division, which stays stable.
+	constexpr _MX_SIZE_T_ newtonDivThreshold = 256;
+	// Compositions p(q) with more coefficients in p than this split p in halves over precomputed powers q^(2^k).
+	constexpr _MX_SIZE_T_ composeThreshold = 16;
+	// GCDs over exact fields run the half-GCD recursion down to this degree and plain Euclid below it.
+	constexpr _MX_SIZE_T_ halfGcdThreshold = 64;
+
+	// Coefficient types with exact division, such as integers modulo a prime; gcd() uses the half-GCD on these.
+	template<typename T>
+	struct exactField : std::false_type {};
+	template<uint32_t _P>
+	struct exactField<modint<_P>> : std::true_type {};
+	template<size_t _I>
+	struct exactField<modint256<_I>> : std::true_type {};
+
+	// Roots of integer polynomials are computed in double; floating-point and complex coefficients keep their precision.
+	template<typename T>
+	using rootBase = std::conditional_t<std::is_floating_point_v<typename cxType<T>::base>, typename cxType<T>::base, double>;
+
+	template<typename B>
+	struct rootOptions {
+		B tol = 4 * std::numeric_limits<B>::epsilon();
+		size_t maxIter = 500;
+		execution pol = execution::seq;
+		// Split off repeated roots with a square-free decomposition first; each root is then reported once per multiplicity.
+		bool squareFree = false;
+	};
+
+	// Coefficients stored from the constant term up, with the order fixed at compile time so evaluation fully unrolls.
+	template<typename T, _MX_SIZE_T_ _N>
+	class fixedPolynom {
+	private:
+		std::array<T, _N + 1> buf;
+	public:
+		MATHPLUSPLUS_API constexpr fixedPolynom();
+		template<typename U>
+		MATHPLUSPLUS_API constexpr fixedPolynom(const std::array<U, _N + 1>& buff);
+		template<typename U>
+		MATHPLUSPLUS_API constexpr fixedPolynom(const std::initializer_list<U>& buff);
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline static const _MX_SIZE_T_ order();
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& operator[](const _MX_SIZE_T_& n);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& operator[](const _MX_SIZE_T_& n) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator()(const U& x) const;
+	};
+
 	template<typename T>
 	class polynom {
 	private:
@@ -62,19 +157,45 @@ namespace math {
 		template<typename U>
 		MATHPLUSPLUS_API constexpr polynom(const std::initializer_list<U>& buff);
 		template<typename U>
+		MATHPLUSPLUS_API constexpr polynom(const std::vector<U>& buff);
+		template<typename U>
 		MATHPLUSPLUS_API constexpr polynom(const polynom<U>& x);
 
 		MATHPLUSPLUS_API constexpr inline void pop();
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const _MX_SIZE_T_ order() const;
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const std::vector<typename cxType<T>::type> solve() const;
+		template<typename B = rootBase<T>>
+		MATHPLUSPLUS_API [[nodiscard]] const std::vector<complex<B>> solve(const rootOptions<B>& opt = {}) const;
 
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& operator[](const _MX_SIZE_T_& n);
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto horner(const U& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto estrin(const U& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const std::pair<polynom<T>, polynom<T>> divmod(const polynom<U>& x) const;
 
+		// The overloads taking `out` reuse its storage and may alias *this; the in-place forms never allocate more than once.
+		MATHPLUSPLUS_API void derivative(polynom<T>& out) const;
+		MATHPLUSPLUS_API [[nodiscard]] polynom<T> derivative() const;
+		MATHPLUSPLUS_API polynom<T>& differentiate();
+		MATHPLUSPLUS_API void antiderivative(polynom<T>& out, const T& c = T(0)) const;
+		MATHPLUSPLUS_API [[nodiscard]] polynom<T> antiderivative(const T& c = T(0)) const;
+		MATHPLUSPLUS_API polynom<T>& integrate(const T& c = T(0));
+		template<typename U>
+		MATHPLUSPLUS_API void compose(const polynom<U>& q, polynom<T>& out) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] polynom<T> compose(const polynom<U>& q) const;
 		template<typename U>
+		MATHPLUSPLUS_API polynom<T>& substitute(const polynom<U>& q);
+
+		MATHPLUSPLUS_API void evalN(std::span<const T> xs, std::span<T> out, const execution pol = execution::seq) const;
+		template<typename C = typename cxType<T>::type> requires (!std::is_same_v<C, T>)
+		MATHPLUSPLUS_API void evalN(std::type_identity_t<std::span<const C>> xs, std::type_identity_t<std::span<C>> out, const execution pol = execution::seq) const;
+
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& operator[](const _MX_SIZE_T_& n);
+
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& operator[](const _MX_SIZE_T_& n) const;
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T operator()(const U& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator()(const U& x) const;
 
 		template<typename U>
 		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool operator==(const polynom<U>& x) const;
@@ -105,22 +226,201 @@ namespace math {
 		MATHPLUSPLUS_API constexpr inline polynom<T>& operator%=(const polynom<U>& x);
 
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator+(const U& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator+(const U& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator+(const U& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator+(const polynom<U>& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator+(const polynom<U>& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator-(const U& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator-(const U& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator-(const polynom<U>& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator-(const polynom<U>& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator*(const U& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator*(const U& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator*(const polynom<U>& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator*(const polynom<U>& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator/(const U& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator/(const U& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator/(const polynom<U>& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator/(const polynom<U>& x) &&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator%(const polynom<U>& x) const&;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> operator%(const polynom<U>& x) &&;
+	};
+
+	// Integer coefficients use a primitive remainder sequence and exact fields the half-GCD. Floating-point and complex
+	// coefficients run Euclid on normalized remainders, treating anything below tol relative to the inputs as zero.
+	// The result is monic, or primitive with a positive leading coefficient for integers.
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> gcd(const polynom<T>& a, const polynom<T>& b, const rootBase<T> tol = std::sqrt(std::numeric_limits<rootBase<T>>::epsilon()));
+	// Yun's algorithm: entry i is the product of the distinct factors of multiplicity i + 1, so p is, up to a constant,
+	// the product of res[i]^(i + 1).
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] std::vector<polynom<T>> squareFreeFactors(const polynom<T>& p, const rootBase<T> tol = std::sqrt(std::numeric_limits<rootBase<T>>::epsilon()));
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] T resultant(const polynom<T>& a, const polynom<T>& b);
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] T discriminant(const polynom<T>& p);
+	// base^e mod m by binary powering, each product reduced with a power-series inverse of the reversed m computed once.
+	// The leading coefficient of m must be invertible.
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> powMod(const polynom<T>& base, uint64_t e, const polynom<T>& m);
+	// Shortest linear recurrence of s over a field, as the connection polynomial 1 + c1 x + ... + cL x^L with
+	// s[n] + c1 s[n - 1] + ... + cL s[n - L] = 0.
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> berlekampMassey(const std::vector<T>& s);
+
+	// Products of the factors (x - x_i) over a fixed point set, kept level by level so that any number of
+	// polynomials can be evaluated at, or interpolated through, the same points in O(M(n) log n).
+	// Exact for modular coefficients; integral interpolation is exact only when every Lagrange weight divides.
+	// The tree is unstable in floating point, so floating-point and complex coefficients fall back to Horner
+	// evaluation and O(n^2) Newton interpolation. Even then the monomial coefficients of a high-order interpolant
+	// are ill-conditioned: at 40 Chebyshev points in double the residual is around 1e-3, at 64 around 1e6.
+	template<typename T>
+	class subproductTree {
+	private:
+		std::vector<T> pts;
+		// levels[0] holds the linear factors, every level above the pairwise products of the one below
+		std::vector<std::vector<polynom<T>>> levels;
+	public:
+		MATHPLUSPLUS_API subproductTree(const std::vector<T>& points, const execution pol = execution::seq);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t size() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<T>& points() const;
+		MATHPLUSPLUS_API [[nodiscard]] const polynom<T> root() const;
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const std::vector<T> evaluate(const polynom<U>& p, const execution pol = execution::seq) const;
+		MATHPLUSPLUS_API [[nodiscard]] const polynom<T> interpolate(const std::vector<T>& values, const execution pol = execution::seq) const;
+	};
+
+	// Terms stored as (exponent, coefficient) pairs sorted by exponent, for high orders with few nonzero coefficients.
+	template<typename T>
+	class sparse_polynom {
+	private:
+		std::vector<std::pair<uint64_t, T>> buf;
+
+		void compact();
+	public:
+		MATHPLUSPLUS_API sparse_polynom();
+		MATHPLUSPLUS_API sparse_polynom(const std::initializer_list<std::pair<uint64_t, T>>& terms);
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator+(const polynom<U>& x) const;
+		MATHPLUSPLUS_API sparse_polynom(const std::vector<std::pair<uint64_t, U>>& terms);
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const U& x) const;
+		MATHPLUSPLUS_API sparse_polynom(const polynom<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_polynom(const sparse_polynom<U>& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const uint64_t order() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t size() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<std::pair<uint64_t, T>>& terms() const;
+		MATHPLUSPLUS_API [[nodiscard]] const T at(const uint64_t e) const;
+		template<typename U>
+		MATHPLUSPLUS_API sparse_polynom<T>& insert(const uint64_t e, const U& x);
+		MATHPLUSPLUS_API [[nodiscard]] const polynom<T> toDense() const;
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator()(const U& x) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator==(const sparse_polynom<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator!=(const sparse_polynom<U>& x) const;
+
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const polynom<U>& x) const;
+		MATHPLUSPLUS_API sparse_polynom<T>& operator+=(const sparse_polynom<U>& x);
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const U& x) const;
+		MATHPLUSPLUS_API sparse_polynom<T>& operator-=(const sparse_polynom<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_polynom<T>& operator*=(const U& x);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_polynom<T>& operator*=(const sparse_polynom<U>& x);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_polynom<T>& operator/=(const U& x);
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> operator+(const sparse_polynom<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> operator-(const sparse_polynom<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> operator*(const U& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> operator*(const sparse_polynom<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> operator/(const U& x) const;
+	};
+
+	// Polynomials in _V variables. Each monomial packs its exponents into one 64-bit key, 64 / _V bits per
+	// variable with x0 in the highest field, so multiplying monomials is one integer addition and comparing
+	// keys is lexicographic order. Terms live in a hash map keyed by the packed monomial.
+	template<typename T, _MX_SIZE_T_ _V>
+	class mpolynom {
+		static_assert(_V >= 1 && _V <= 16, "math::mpolynom supports 1 to 16 variables");
+	public:
+		using monomial = std::array<uint32_t, _V>;
+		static constexpr unsigned bits = 64 / _V;
+		static constexpr uint64_t maxExponent = bits == 64 ? ~0ull : (1ull << bits) - 1;
+	private:
+		std::unordered_map<uint64_t, T> buf;
+	public:
+		MATHPLUSPLUS_API mpolynom();
+		MATHPLUSPLUS_API mpolynom(const std::initializer_list<std::pair<monomial, T>>& terms);
+		template<typename U>
+		MATHPLUSPLUS_API mpolynom(const mpolynom<U, _V>& x);
+		MATHPLUSPLUS_API [[nodiscard]] static const mpolynom<T, _V> var(const _MX_SIZE_T_ i);
+
+		MATHPLUSPLUS_API [[nodiscard]] static inline const uint64_t pack(const monomial& m);
+		MATHPLUSPLUS_API [[nodiscard]] static inline const monomial unpack(const uint64_t k);
+		MATHPLUSPLUS_API [[nodiscard]] static const bool less(const monomial& a, const monomial& b, const monomialOrder ord);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t size() const;
+		MATHPLUSPLUS_API [[nodiscard]] const uint64_t order() const;
+		MATHPLUSPLUS_API [[nodiscard]] const uint64_t order(const _MX_SIZE_T_ i) const;
+		MATHPLUSPLUS_API [[nodiscard]] const T at(const monomial& m) const;
+		template<typename U>
+		MATHPLUSPLUS_API mpolynom<T, _V>& insert(const monomial& m, const U& x);
+		MATHPLUSPLUS_API [[nodiscard]] const std::vector<std::pair<monomial, T>> terms(const monomialOrder ord = monomialOrder::grlex) const;
+		MATHPLUSPLUS_API [[nodiscard]] const std::pair<monomial, T> leading(const monomialOrder ord = monomialOrder::grlex) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator()(const std::array<U, _V>& x) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator==(const mpolynom<U, _V>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator!=(const mpolynom<U, _V>& x) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API mpolynom<T, _V>& operator+=(const mpolynom<U, _V>& x);
+		template<typename U>
+		MATHPLUSPLUS_API mpolynom<T, _V>& operator-=(const mpolynom<U, _V>& x);
+		template<typename U>
+		MATHPLUSPLUS_API mpolynom<T, _V>& operator*=(const U& x);
+		template<typename U>
+		MATHPLUSPLUS_API mpolynom<T, _V>& operator*=(const mpolynom<U, _V>& x);
+
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const polynom<U>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> operator+(const mpolynom<U, _V>& x) const;
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator/(const U& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> operator-(const mpolynom<U, _V>& x) const;
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator/(const polynom<U>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> operator*(const U& x) const;
 		template<typename U>
-		MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator%(const polynom<U>& x) const;
+		MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> operator*(const mpolynom<U, _V>& x) const;
 	};
 }
\ No newline at end of file
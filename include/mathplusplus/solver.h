@@ -0,0 +1,163 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <vector>
+#include <concepts>
+#include <stdexcept>
+#include <functional>
+#include "dmatrix.h"
+#include "sparse.h"
+#include "parallel.h"
+
+namespace math {
+
+	class singular_preconditioner : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API singular_preconditioner();
+	};
+
+	template<typename A, typename T>
+	concept linearOperator = requires(const A& a, const std::vector<T>& x, std::vector<T>& y) {
+		{ a.height() } -> std::convertible_to<size_t>;
+		a.apply(x, y);
+	};
+
+	template<typename M, typename T>
+	concept preconditioner = requires(const M& m, const std::vector<T>& r, std::vector<T>& z) {
+		m.apply(r, z);
+	};
+
+	template<typename T, typename F>
+	class functionOperator {
+	private:
+		size_t n;
+		F f;
+	public:
+		MATHPLUSPLUS_API functionOperator(const size_t n, F f);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		MATHPLUSPLUS_API void apply(const std::vector<T>& x, std::vector<T>& y) const;
+	};
+
+	template<typename T>
+	class identityPreconditioner {
+	public:
+		MATHPLUSPLUS_API void apply(const std::vector<T>& r, std::vector<T>& z) const;
+	};
+
+	template<typename T>
+	class jacobiPreconditioner {
+	private:
+		std::vector<T> inv;
+	public:
+		template<typename U>
+		MATHPLUSPLUS_API jacobiPreconditioner(const dmatrix<U>& a);
+		template<typename U>
+		MATHPLUSPLUS_API jacobiPreconditioner(const sparse_matrix<U>& a);
+
+		MATHPLUSPLUS_API void apply(const std::vector<T>& r, std::vector<T>& z) const;
+	};
+
+	template<typename T>
+	class ilu0Preconditioner {
+	private:
+		std::vector<size_t> row, col, diag;
+		std::vector<T> val;
+	public:
+		template<typename U>
+		MATHPLUSPLUS_API ilu0Preconditioner(const sparse_matrix<U>& a);
+		template<typename U>
+		MATHPLUSPLUS_API ilu0Preconditioner(const dmatrix<U>& a);
+
+		MATHPLUSPLUS_API void apply(const std::vector<T>& r, std::vector<T>& z) const;
+	};
+
+	template<typename T>
+	class luPreconditioner {
+	private:
+		dmatrix<T> lu;
+		std::vector<size_t> perm;
+	public:
+		template<typename U>
+		MATHPLUSPLUS_API luPreconditioner(const dmatrix<U>& a, const execution pol = execution::seq);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		template<typename U>
+		MATHPLUSPLUS_API void apply(const std::vector<U>& r, std::vector<U>& z) const;
+	};
+
+	template<typename T>
+	struct solverOptions {
+		T tol = T(1e-10);
+		size_t maxIter = 1000;
+		size_t restart = 30;
+		execution pol = execution::seq;
+		std::function<void(size_t, T)> trace;
+	};
+
+	template<typename T>
+	struct solverResult {
+		size_t iterations;
+		T residual;
+		bool converged;
+	};
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> cg(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt = {});
+	template<typename T, typename A> requires linearOperator<A, T>
+	MATHPLUSPLUS_API solverResult<T> cg(const A& a, const std::vector<T>& b, std::vector<T>& x, const solverOptions<T>& opt = {});
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> bicgstab(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt = {});
+	template<typename T, typename A> requires linearOperator<A, T>
+	MATHPLUSPLUS_API solverResult<T> bicgstab(const A& a, const std::vector<T>& b, std::vector<T>& x, const solverOptions<T>& opt = {});
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> gmres(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt = {});
+	template<typename T, typename A> requires linearOperator<A, T>
+	MATHPLUSPLUS_API solverResult<T> gmres(const A& a, const std::vector<T>& b, std::vector<T>& x, const solverOptions<T>& opt = {});
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> refine(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt = {});
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_matrix<T> poisson2d(const size_t n);
+}
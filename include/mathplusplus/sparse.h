@@ -0,0 +1,133 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "dmatrix.h"
+#include "parallel.h"
+
+namespace math {
+
+	class sparse_format_error : public std::runtime_error {
+	public:
+		MATHPLUSPLUS_API sparse_format_error();
+	};
+
+	enum class sparseFormat {
+		coo,
+		csr,
+		csc
+	};
+
+	template<typename T>
+	class sparse_matrix {
+	protected:
+		size_t h, w;
+		sparseFormat fmt;
+		// coo: row of every entry, csr: row starts, csc: column starts
+		std::vector<size_t> outr;
+		// coo and csr: column of every entry, csc: row of every entry
+		std::vector<size_t> innr;
+		std::vector<T> val;
+	public:
+		MATHPLUSPLUS_API sparse_matrix();
+		MATHPLUSPLUS_API sparse_matrix(const size_t h, const size_t w);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_matrix(const dmatrix<U>& x, const sparseFormat f = sparseFormat::csr);
+		template<typename U, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+		MATHPLUSPLUS_API sparse_matrix(const matrix<U, _H, _W, _L>& x, const sparseFormat f = sparseFormat::csr);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_matrix(const sparse_matrix<U>& x);
+		MATHPLUSPLUS_API sparse_matrix(const size_t h, const size_t w, const sparseFormat f, std::vector<size_t>&& outer, std::vector<size_t>&& inner, std::vector<T>&& values);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t width() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t nnz() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const sparseFormat format() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<size_t>& outer() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<size_t>& inner() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<T>& values() const;
+
+		MATHPLUSPLUS_API void reserve(const size_t n);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_matrix<T>& insert(const size_t i, const size_t j, const U& x);
+		MATHPLUSPLUS_API sparse_matrix<T>& compress(const sparseFormat f = sparseFormat::csr);
+
+		MATHPLUSPLUS_API [[nodiscard]] const T at(const size_t i, const size_t j) const;
+		MATHPLUSPLUS_API [[nodiscard]] const sparse_matrix<T> trans() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const transView<sparse_matrix<T>> t() const;
+		MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> toDense() const;
+		template<_MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L = rowMajor>
+		MATHPLUSPLUS_API [[nodiscard]] const matrix<T, _H, _W, _L> toMatrix() const;
+
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void apply(const std::vector<U>& x, std::vector<V>& y, const execution pol = execution::seq) const;
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void applyTrans(const std::vector<U>& x, std::vector<V>& y, const execution pol = execution::seq) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto spmv(const std::vector<U>& x, const execution pol = execution::seq) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto spmm(const dmatrix<U>& x, const execution pol = execution::seq) const;
+
+		template<typename U>
+		MATHPLUSPLUS_API sparse_matrix<T>& operator*=(const U& x);
+		template<typename U>
+		MATHPLUSPLUS_API sparse_matrix<T>& operator/=(const U& x);
+
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const std::vector<U>& x) const;
+		template<typename U>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const dmatrix<U>& x) const;
+	};
+
+	template<typename T>
+	struct isMatrixType<sparse_matrix<T>> : std::true_type {};
+
+	template<typename T>
+	struct cxType;
+
+	template<typename T>
+	struct cxType<sparse_matrix<T>> {
+		using type = sparse_matrix<typename cxType<T>::type>;
+		using base = sparse_matrix<typename cxType<T>::base>;
+	};
+}
@@ -0,0 +1,128 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#pragma once
+
+#ifdef MATHPLUSPLUS_EXPORTS
+#define MATHPLUSPLUS_API _declspec(dllexport)
+#else
+#define MATHPLUSPLUS_API _declspec(dllimport)
+#endif // MATHPLUSPLUS_EXPORTS
+
+#include <stddef.h>
+#include <vector>
+#include <concepts>
+#include <type_traits>
+#include "matrix.h"
+#include "dmatrix.h"
+#include "parallel.h"
+
+namespace math {
+
+	template<typename M>
+	concept matrixLike = requires(const M& m, const size_t i) {
+		{ m.height() } -> std::convertible_to<size_t>;
+		{ m.width() } -> std::convertible_to<size_t>;
+		m(i, i);
+	};
+
+	template<typename T>
+	class matrixView {
+	private:
+		T* p;
+		size_t h, w, rs, cs;
+
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API [[nodiscard]] const bool overlaps(const M& x) const;
+	public:
+		using value_type = std::remove_const_t<T>;
+
+		MATHPLUSPLUS_API matrixView(T* p, const size_t h, const size_t w, const size_t rs, const size_t cs = 1);
+		MATHPLUSPLUS_API matrixView(const matrixView<T>& x) = default;
+		template<typename U> requires (!std::is_same_v<U, T> && std::is_convertible_v<U*, T*>)
+		MATHPLUSPLUS_API matrixView(const matrixView<U>& x);
+
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t height() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t width() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t rowStride() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline const size_t colStride() const;
+		MATHPLUSPLUS_API [[nodiscard]] inline T* data() const;
+
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep = 1, const size_t cstep = 1) const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> row(const size_t i) const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> col(const size_t j) const;
+		MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> t() const;
+		MATHPLUSPLUS_API [[nodiscard]] const dmatrix<value_type> eval() const;
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API [[nodiscard]] const auto mul(const M& x, const execution pol = execution::seq) const;
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void apply(const std::vector<U>& x, std::vector<V>& y, const execution pol = execution::seq) const;
+		template<typename U, typename V>
+		MATHPLUSPLUS_API void applyTrans(const std::vector<U>& x, std::vector<V>& y, const execution pol = execution::seq) const;
+
+		MATHPLUSPLUS_API [[nodiscard]] inline T& operator()(const size_t& i, const size_t& j) const;
+
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator==(const M& x) const;
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API [[nodiscard]] const bool operator!=(const M& x) const;
+
+		MATHPLUSPLUS_API const matrixView<T>& operator=(const matrixView<T>& x) const;
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API const matrixView<T>& operator=(const M& x) const;
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API const matrixView<T>& operator+=(const M& x) const;
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API const matrixView<T>& operator-=(const M& x) const;
+		template<typename U> requires (!isMatrixType<U>::value)
+		MATHPLUSPLUS_API const matrixView<T>& operator*=(const U& x) const;
+		template<typename U> requires (!isMatrixType<U>::value)
+		MATHPLUSPLUS_API const matrixView<T>& operator/=(const U& x) const;
+
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator+(const M& x) const;
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator-(const M& x) const;
+		template<typename U> requires (!isMatrixType<U>::value)
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const U& x) const;
+		template<typename M> requires matrixLike<M>
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const M& x) const;
+		template<typename U> requires (!isMatrixType<U>::value)
+		MATHPLUSPLUS_API [[nodiscard]] const auto operator/(const U& x) const;
+	};
+
+	template<typename T>
+	struct isMatrixType<matrixView<T>> : std::true_type {};
+
+	template<typename U, typename T> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const U& x, const matrixView<T>& m);
+}
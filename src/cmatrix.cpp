@@ -0,0 +1,321 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "cmatrix.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace math {
+
+	template<typename T>
+	MATHPLUSPLUS_API cmatrix<T>::cmatrix() {}
+	template<typename T>
+	MATHPLUSPLUS_API cmatrix<T>::cmatrix(const size_t h, const size_t w) : r(h, w), i(h, w) {}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API cmatrix<T>::cmatrix(const dmatrix<U>& re, const dmatrix<U>& im) : r(re), i(im) {
+		if (re.height() != im.height() || re.width() != im.width()) throw dimension_mismatch();
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API cmatrix<T>::cmatrix(const dmatrix<complex<U>>& x) : r(x.height(), x.width()), i(x.height(), x.width()) {
+		const complex<U>* a = x.data();
+		T* re = r.data(), * im = i.data();
+		for (size_t k = 0; k < x.height() * x.width(); k++) {
+			re[k] = a[k].re;
+			im[k] = a[k].im;
+		}
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t cmatrix<T>::height() const {
+		return r.height();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t cmatrix<T>::width() const {
+		return r.width();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline dmatrix<T>& cmatrix<T>::real() {
+		return r;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const dmatrix<T>& cmatrix<T>::real() const {
+		return r;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline dmatrix<T>& cmatrix<T>::imag() {
+		return i;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const dmatrix<T>& cmatrix<T>::imag() const {
+		return i;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<complex<T>> cmatrix<T>::eval() const {
+		dmatrix<complex<T>> res(height(), width());
+		complex<T>* out = res.data();
+		const T* re = r.data(), * im = i.data();
+		for (size_t k = 0; k < height() * width(); k++)
+			out[k] = complex<T>(re[k], im[k]);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> cmatrix<T>::conj() const {
+		cmatrix<T> res(*this);
+		T* im = res.i.data();
+		for (size_t k = 0; k < height() * width(); k++)
+			im[k] = -im[k];
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> cmatrix<T>::trans(const execution pol) const {
+		cmatrix<T> res;
+		res.r = r.trans(pol);
+		res.i = i.trans(pol);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> cmatrix<T>::herm(const execution pol) const {
+		cmatrix<T> res = trans(pol);
+		T* im = res.i.data();
+		for (size_t k = 0; k < height() * width(); k++)
+			im[k] = -im[k];
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto cmatrix<T>::mul(const cmatrix<U>& x, const execution pol) const {
+		if (width() != x.height()) throw dimension_mismatch();
+		using V = std::remove_cv_t<decltype(T() * U())>;
+		// 3M: three real products instead of four, each running on the vectorized real kernels.
+		const dmatrix<V> p1 = r.mul(x.r, pol), p2 = i.mul(x.i, pol), p3 = (r + i).mul(x.r + x.i, pol);
+		cmatrix<V> res(height(), x.width());
+		const V* a = p1.data(), * b = p2.data(), * c = p3.data();
+		V* re = res.r.data(), * im = res.i.data();
+		parallelFor(pol, 0, height() * x.width(), 16384, [&](const size_t lo, const size_t hi) {
+			for (size_t k = lo; k < hi; k++) {
+				re[k] = a[k] - b[k];
+				im[k] = c[k] - a[k] - b[k];
+			}
+		});
+		return res;
+	}
+	template<typename T>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void cmatrix<T>::apply(const std::vector<complex<U>>& x, std::vector<complex<V>>& y, const execution pol) const {
+		const size_t h = height(), w = width();
+		if (x.size() != w) throw dimension_mismatch();
+		std::vector<U> xr(w), xi(w);
+		for (size_t j = 0; j < w; j++) {
+			xr[j] = x[j].re;
+			xi[j] = x[j].im;
+		}
+		y.resize(h);
+		parallelFor(pol, 0, h, std::max<size_t>(1, 16384 / std::max<size_t>(w, 1)), [&](const size_t lo, const size_t hi) {
+			for (size_t k = lo; k < hi; k++) {
+				const T* ar = r[k], * ai = i[k];
+				V sr = 0, si = 0;
+				for (size_t j = 0; j < w; j++) {
+					sr += ar[j] * xr[j] - ai[j] * xi[j];
+					si += ar[j] * xi[j] + ai[j] * xr[j];
+				}
+				y[k] = complex<V>(sr, si);
+			}
+		});
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const complex<T> cmatrix<T>::operator()(const size_t& i, const size_t& j) const {
+		return complex<T>(r(i, j), this->i(i, j));
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool cmatrix<T>::operator==(const cmatrix<U>& x) const {
+		return r == x.r && i == x.i;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool cmatrix<T>::operator!=(const cmatrix<U>& x) const {
+		return !(*this == x);
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API cmatrix<T>& cmatrix<T>::operator+=(const cmatrix<U>& x) {
+		r += x.r;
+		i += x.i;
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API cmatrix<T>& cmatrix<T>::operator-=(const cmatrix<U>& x) {
+		r -= x.r;
+		i -= x.i;
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API cmatrix<T>& cmatrix<T>::operator*=(const complex<U>& x) {
+		T* re = r.data(), * im = i.data();
+		for (size_t k = 0; k < height() * width(); k++) {
+			const T a = re[k], b = im[k];
+			re[k] = a * x.re - b * x.im;
+			im[k] = a * x.im + b * x.re;
+		}
+		return *this;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto cmatrix<T>::operator+(const cmatrix<U>& x) const {
+		using V = std::remove_cv_t<decltype(T() + U())>;
+		cmatrix<V> res(r + x.r, i + x.i);
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto cmatrix<T>::operator-(const cmatrix<U>& x) const {
+		using V = std::remove_cv_t<decltype(T() - U())>;
+		cmatrix<V> res(r - x.r, i - x.i);
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto cmatrix<T>::operator*(const cmatrix<U>& x) const {
+		return mul(x);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const cmatrix<T> cmatrix<T>::operator*(const complex<T>& x) const {
+		cmatrix<T> res(*this);
+		return res *= x;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API cluPreconditioner<T>::cluPreconditioner(const cmatrix<U>& a, const execution pol) : lu(a.real(), a.imag()), perm(a.height()), odd(false) {
+		if (a.height() != a.width()) throw non_square_matrix();
+		const size_t n = a.height();
+		dmatrix<T>& fr = lu.real(), & fi = lu.imag();
+		for (size_t k = 0; k < n; k++)
+			perm[k] = k;
+		for (size_t k = 0; k < n; k++) {
+			size_t p = k;
+			T best = fr(k, k) * fr(k, k) + fi(k, k) * fi(k, k);
+			for (size_t q = k + 1; q < n; q++) {
+				const T m = fr(q, k) * fr(q, k) + fi(q, k) * fi(q, k);
+				if (m > best) {
+					best = m;
+					p = q;
+				}
+			}
+			if (best == T(0)) throw singular_matrix();
+			if (p != k) {
+				std::swap_ranges(fr[k], fr[k] + n, fr[p]);
+				std::swap_ranges(fi[k], fi[k] + n, fi[p]);
+				std::swap(perm[k], perm[p]);
+				odd = !odd;
+			}
+			const T* pr = fr[k], * pi = fi[k];
+			const T dr = pr[k] / best, di = -pi[k] / best;
+			parallelFor(pol, k + 1, n, std::max<size_t>(1, 8192 / (n - k)), [&](const size_t lo, const size_t hi) {
+				for (size_t q = lo; q < hi; q++) {
+					T* rr = fr[q], * ri = fi[q];
+					const T lr = rr[k] * dr - ri[k] * di, li = rr[k] * di + ri[k] * dr;
+					rr[k] = lr;
+					ri[k] = li;
+					for (size_t j = k + 1; j < n; j++) {
+						rr[j] -= lr * pr[j] - li * pi[j];
+						ri[j] -= lr * pi[j] + li * pr[j];
+					}
+				}
+			});
+		}
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t cluPreconditioner<T>::height() const {
+		return lu.height();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const complex<T> cluPreconditioner<T>::det() const {
+		T dr = odd ? T(-1) : T(1), di = 0;
+		for (size_t k = 0; k < height(); k++) {
+			const T a = lu.real()(k, k), b = lu.imag()(k, k), t = dr * a - di * b;
+			di = dr * b + di * a;
+			dr = t;
+		}
+		return complex<T>(dr, di);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API void cluPreconditioner<T>::apply(const std::vector<complex<U>>& r, std::vector<complex<U>>& z) const {
+		const size_t n = height();
+		const dmatrix<T>& fr = lu.real(), & fi = lu.imag();
+		std::vector<T> yr(n), yi(n);
+		for (size_t k = 0; k < n; k++) {
+			T sr = r[perm[k]].re, si = r[perm[k]].im;
+			const T* ar = fr[k], * ai = fi[k];
+			for (size_t j = 0; j < k; j++) {
+				sr -= ar[j] * yr[j] - ai[j] * yi[j];
+				si -= ar[j] * yi[j] + ai[j] * yr[j];
+			}
+			yr[k] = sr;
+			yi[k] = si;
+		}
+		for (size_t k = n; k-- > 0;) {
+			T sr = yr[k], si = yi[k];
+			const T* ar = fr[k], * ai = fi[k];
+			for (size_t j = k + 1; j < n; j++) {
+				sr -= ar[j] * yr[j] - ai[j] * yi[j];
+				si -= ar[j] * yi[j] + ai[j] * yr[j];
+			}
+			const T m = ar[k] * ar[k] + ai[k] * ai[k];
+			yr[k] = (sr * ar[k] + si * ai[k]) / m;
+			yi[k] = (si * ar[k] - sr * ai[k]) / m;
+		}
+		z.resize(n);
+		for (size_t k = 0; k < n; k++)
+			z[k] = complex<U>(yr[k], yi[k]);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<complex<T>> herm(const dmatrix<complex<T>>& a, const execution pol) {
+		dmatrix<complex<T>> res = a.trans(pol);
+		complex<T>* out = res.data();
+		for (size_t k = 0; k < a.height() * a.width(); k++)
+			out[k].im = -out[k].im;
+		return res;
+	}
+}
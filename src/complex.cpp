@@ -104,7 +104,7 @@ namespace math {
 	}
 
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API constexpr inline complex<T>& complex<T>::operator=(const U& x) {
 		re = x;
 		im = 0;
@@ -118,7 +118,7 @@ namespace math {
 		return *this;
 	}
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API constexpr inline complex<T>& complex<T>::operator+=(const U& x) {
 		re += x;
 		return *this;
@@ -131,7 +131,7 @@ namespace math {
 		return *this;
 	}
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API constexpr inline complex<T>& complex<T>::operator-=(const U& x) {
 		re -= x;
 		return *this;
@@ -144,7 +144,7 @@ namespace math {
 		return *this;
 	}
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API constexpr inline complex<T>& complex<T>::operator*=(const U& x) {
 		re *= x;
 		im *= x;
@@ -159,7 +159,7 @@ namespace math {
 		return *this;
 	}
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API constexpr inline complex<T>& complex<T>::operator/=(const U& x) {
 		re /= x;
 		im /= x;
@@ -175,7 +175,7 @@ namespace math {
 	}
 
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto complex<T>::operator+(const U& x) const {
 		using V = decltype(T() + U());
 		complex<V> res(re + x, im);
@@ -189,7 +189,7 @@ namespace math {
 		return res;
 	}
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto complex<T>::operator-(const U& x) const {
 		using V = decltype(T() - U());
 		complex<V> res(re - x, im);
@@ -203,7 +203,7 @@ namespace math {
 		return res;
 	}
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto complex<T>::operator*(const U& x) const {
 		using V = decltype(T()* U());
 		complex<V> res(re * x, im * x);
@@ -217,7 +217,7 @@ namespace math {
 		return res;
 	}
 	template<typename T>
-	template<typename U>
+	template<typename U> requires (!isComplex<U>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto complex<T>::operator/(const U& x) const {
 		using V = decltype(T() / U());
 		complex<V> res(re / x, im / x);
@@ -231,25 +231,25 @@ namespace math {
 		return res;
 	}
 
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator+(const T& x, const complex<U>& y) {
 		using V = decltype(T() + U());
 		complex<V> res(x + y.re, y.im);
 		return res;
 	}
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator-(const T& x, const complex<U>& y) {
 		using V = decltype(T() - U());
 		complex<V> res(x - y.re, -y.im);
 		return res;
 	}
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const T& x, const complex<U>& y) {
 		using V = decltype(T()* U());
 		complex<V> res(x * y.re, x * y.im);
 		return res;
 	}
-	template<typename T, typename U>
+	template<typename T, typename U> requires (!isComplex<T>::value)
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator/(const T& x, const complex<U>& y) {
 		using V = decltype(T() / U());
 		complex<V> res(x * y.re / y.norm(), -x * y.im / y.norm());
@@ -257,18 +257,18 @@ namespace math {
 	}
 
 	template<typename T, typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto cxFromPolar(const T& r, const U& theta) {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const complex<T> cxFromPolar(const T& r, const U& theta) {
 		complex<T> res(r * cos(theta), r * sin(theta));
 		return res;
 	}
 
 	template<typename T>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto cxSqrt(const complex<T>& x) {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const complex<T> cxSqrt(const complex<T>& x) {
 		return cxFromPolar(sqrt(x.norm()), x.arg() / 2);
 	}
 
 	template<typename T>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto cxCbrt(const complex<T>& x) {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const complex<T> cxCbrt(const complex<T>& x) {
 		return cxFromPolar(cbrt(x.norm()), x.arg() / 3);
 	}
 
@@ -0,0 +1,682 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "dmatrix.h"
+#include "cmatrix.h"
+#include "exact.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace math {
+
+	MATHPLUSPLUS_API dimension_mismatch::dimension_mismatch() : std::runtime_error("Dimensions of math::dmatrix operands do not match") {}
+
+	MATHPLUSPLUS_API non_square_matrix::non_square_matrix() : std::runtime_error("Operation requires a square matrix") {}
+
+	static std::atomic<size_t> crossover = 128;
+
+	MATHPLUSPLUS_API void setStrassenCrossover(const size_t n) {
+		crossover = n;
+	}
+	MATHPLUSPLUS_API [[nodiscard]] const size_t strassenCrossover() {
+		return crossover;
+	}
+
+	template<typename A, typename B, typename C>
+	static void gemmKernel(const A* a, const size_t lda, const B* b, const size_t ldb, C* c, const size_t ldc, const size_t m, const size_t k, const size_t n, const execution pol) {
+		constexpr size_t tile = 64, depth = 256;
+		using F = typename accumType<B>::type;
+		parallelFor2d(pol, m, n, tile, [&](const size_t r0, const size_t r1, const size_t c0, const size_t c1) {
+			// Compact element types are widened one panel at a time so the inner loop runs on the accumulation type.
+			std::vector<F> panel(std::is_same_v<F, B> ? 0 : depth * tile);
+			for (size_t k0 = 0; k0 < k; k0 += depth) {
+				const size_t k1 = std::min(k, k0 + depth);
+				if constexpr (!std::is_same_v<F, B>)
+					for (size_t p = k0; p < k1; p++)
+						toFloat(b + p * ldb + c0, panel.data() + (p - k0) * tile, c1 - c0);
+				auto panelRow = [&](const size_t p) -> const F* {
+					if constexpr (std::is_same_v<F, B>)
+						return b + p * ldb + c0;
+					else
+						return panel.data() + (p - k0) * tile;
+				};
+				size_t i = r0;
+				for (; i + 4 <= r1; i += 4) {
+					const A* row = a + i * lda;
+					size_t j = c0;
+					// A 4x8 block of c stays in registers across the whole depth panel.
+					for (; j + 8 <= c1; j += 8) {
+						C acc[4][8] = {};
+						for (size_t p = k0; p < k1; p++) {
+							const F* r = panelRow(p) + (j - c0);
+							const C a0 = row[p], a1 = row[lda + p], a2 = row[2 * lda + p], a3 = row[3 * lda + p];
+							for (size_t t = 0; t < 8; t++) {
+								const C x = r[t];
+								acc[0][t] += a0 * x;
+								acc[1][t] += a1 * x;
+								acc[2][t] += a2 * x;
+								acc[3][t] += a3 * x;
+							}
+						}
+						for (size_t s = 0; s < 4; s++)
+							for (size_t t = 0; t < 8; t++)
+								c[(i + s) * ldc + j + t] += acc[s][t];
+					}
+					for (size_t s = 0; s < 4; s++) {
+						C* out = c + (i + s) * ldc;
+						for (size_t p = k0; p < k1; p++) {
+							const C aip = row[s * lda + p];
+							const F* r = panelRow(p);
+							for (size_t q = j; q < c1; q++)
+								out[q] += aip * r[q - c0];
+						}
+					}
+				}
+				for (; i < r1; i++) {
+					C* out = c + i * ldc;
+					const A* row = a + i * lda;
+					for (size_t p = k0; p < k1; p++) {
+						const C aip = row[p];
+						const F* r = panelRow(p);
+						for (size_t j = c0; j < c1; j++)
+							out[j] += aip * r[j - c0];
+					}
+				}
+			}
+		});
+	}
+
+	template<typename V>
+	static void wideGemm(const V* a, const V* b, V* c, const size_t m, const size_t k, const size_t n, const execution pol) {
+		constexpr size_t limbs = sizeof(V) / sizeof(uint32_t);
+		std::vector<uint32_t> la(m * k * limbs), lb(n * k * limbs);
+		for (size_t i = 0; i < m * k; i++)
+			for (size_t t = 0; t < limbs; t++)
+				la[i * limbs + t] = (uint32_t)(a[i] >> (int)(32 * t));
+		for (size_t p = 0; p < k; p++)
+			for (size_t j = 0; j < n; j++)
+				for (size_t t = 0; t < limbs; t++)
+					lb[(j * k + p) * limbs + t] = (uint32_t)(b[p * n + j] >> (int)(32 * t));
+		parallelFor(pol, 0, m, 1, [&](const size_t lo, const size_t hi) {
+			for (size_t i = lo; i < hi; i++) {
+				for (size_t j = 0; j < n; j++) {
+					// Limb products are split into 32-bit halves and summed per column, so carries are resolved once per entry instead of once per product.
+					uint64_t acc[limbs] = {};
+					const uint32_t* x = &la[i * k * limbs], * y = &lb[j * k * limbs];
+					for (size_t p = 0; p < k; p++, x += limbs, y += limbs)
+						for (size_t s = 0; s < limbs; s++) {
+							const uint64_t xs = x[s];
+							for (size_t t = 0; s + t + 1 < limbs; t++) {
+								const uint64_t q = xs * y[t];
+								acc[s + t] += (uint32_t)q;
+								acc[s + t + 1] += q >> 32;
+							}
+							acc[limbs - 1] += (uint32_t)(xs * y[limbs - 1 - s]);
+						}
+					V r = 0;
+					uint64_t carry = 0;
+					for (size_t t = 0; t < limbs; t++) {
+						carry += acc[t];
+						r = r | (V((uint64_t)(uint32_t)carry) << (int)(32 * t));
+						carry >>= 32;
+					}
+					c[i * n + j] = r;
+				}
+			}
+		});
+	}
+
+	template<bool _Sub, typename V>
+	static void addBlock(const V* a, const size_t lda, const V* b, const size_t ldb, V* c, const size_t ldc, const size_t m, const size_t n, const execution pol) {
+		parallelFor(pol, 0, m, std::max<size_t>(1, 16384 / std::max<size_t>(n, 1)), [&](const size_t lo, const size_t hi) {
+			for (size_t i = lo; i < hi; i++) {
+				const V* x = a + i * lda;
+				const V* y = b + i * ldb;
+				V* z = c + i * ldc;
+				for (size_t j = 0; j < n; j++)
+					z[j] = _Sub ? x[j] - y[j] : x[j] + y[j];
+			}
+		});
+	}
+
+	static const size_t strassenArena(size_t m, size_t k, size_t n, const size_t levels) {
+		size_t s = 0;
+		for (size_t l = 0; l < levels; l++) {
+			m /= 2;
+			k /= 2;
+			n /= 2;
+			s += m * k + k * n + m * n;
+		}
+		return s;
+	}
+
+	template<typename V>
+	static void strassenKernel(const V* a, const size_t lda, const V* b, const size_t ldb, V* c, const size_t ldc, const size_t m, const size_t k, const size_t n, const size_t levels, V* arena, const execution pol) {
+		if (levels == 0) {
+			for (size_t i = 0; i < m; i++)
+				std::fill_n(c + i * ldc, n, V(0));
+			gemmKernel(a, lda, b, ldb, c, ldc, m, k, n, pol);
+			return;
+		}
+		const size_t m2 = m / 2, k2 = k / 2, n2 = n / 2, l = levels - 1;
+		const V* a11 = a, * a12 = a + k2, * a21 = a + m2 * lda, * a22 = a21 + k2;
+		const V* b11 = b, * b12 = b + n2, * b21 = b + k2 * ldb, * b22 = b21 + n2;
+		V* c11 = c, * c12 = c + n2, * c21 = c + m2 * ldc, * c22 = c21 + n2;
+		V* x = arena, * y = x + m2 * k2, * p = y + k2 * n2, * next = p + m2 * n2;
+		addBlock<true>(a11, lda, a21, lda, x, k2, m2, k2, pol);
+		addBlock<true>(b22, ldb, b12, ldb, y, n2, k2, n2, pol);
+		strassenKernel(x, k2, y, n2, c21, ldc, m2, k2, n2, l, next, pol);
+		addBlock<false>(a21, lda, a22, lda, x, k2, m2, k2, pol);
+		addBlock<true>(b12, ldb, b11, ldb, y, n2, k2, n2, pol);
+		strassenKernel(x, k2, y, n2, c22, ldc, m2, k2, n2, l, next, pol);
+		addBlock<true>(x, k2, a11, lda, x, k2, m2, k2, pol);
+		addBlock<true>(b22, ldb, y, n2, y, n2, k2, n2, pol);
+		strassenKernel(x, k2, y, n2, c12, ldc, m2, k2, n2, l, next, pol);
+		addBlock<true>(a12, lda, x, k2, x, k2, m2, k2, pol);
+		strassenKernel(x, k2, b22, ldb, c11, ldc, m2, k2, n2, l, next, pol);
+		strassenKernel(a11, lda, b11, ldb, p, n2, m2, k2, n2, l, next, pol);
+		addBlock<false>(c12, ldc, p, n2, c12, ldc, m2, n2, pol);
+		addBlock<false>(c21, ldc, c12, ldc, c21, ldc, m2, n2, pol);
+		addBlock<false>(c12, ldc, c22, ldc, c12, ldc, m2, n2, pol);
+		addBlock<false>(c22, ldc, c21, ldc, c22, ldc, m2, n2, pol);
+		addBlock<false>(c12, ldc, c11, ldc, c12, ldc, m2, n2, pol);
+		addBlock<true>(y, n2, b21, ldb, y, n2, k2, n2, pol);
+		strassenKernel(a22, lda, y, n2, c11, ldc, m2, k2, n2, l, next, pol);
+		addBlock<true>(c21, ldc, c11, ldc, c21, ldc, m2, n2, pol);
+		strassenKernel(a12, lda, b21, ldb, c11, ldc, m2, k2, n2, l, next, pol);
+		addBlock<false>(c11, ldc, p, n2, c11, ldc, m2, n2, pol);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API dmatrix<T>::dmatrix() : h(0), w(0) {}
+	template<typename T>
+	MATHPLUSPLUS_API dmatrix<T>::dmatrix(const size_t h, const size_t w) : h(h), w(w), buf(h * w, T(0)) {}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>::dmatrix(const size_t h, const size_t w, const U& x) : h(h), w(w), buf(h * w, T(x)) {}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>::dmatrix(const std::initializer_list<std::initializer_list<U>>& buff) : h(buff.size()), w(0) {
+		for (auto& row : buff)
+			w = std::max(w, row.size());
+		buf.assign(h * w, T(0));
+		size_t i = 0;
+		for (auto& row : buff) {
+			size_t j = 0;
+			for (auto& elem : row)
+				buf[i * w + j++] = elem;
+			i++;
+		}
+	}
+	template<typename T>
+	template<typename U, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API dmatrix<T>::dmatrix(const matrix<U, _H, _W, _L>& x) : h(_H), w(_W), buf(_H * _W) {
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				buf[i * w + j] = x(i, j);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>::dmatrix(const dmatrix<U>& x) : h(x.height()), w(x.width()), buf(x.data(), x.data() + x.height() * x.width()) {}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t dmatrix<T>::height() const {
+		return h;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t dmatrix<T>::width() const {
+		return w;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline T* dmatrix<T>::data() {
+		return buf.data();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const T* dmatrix<T>::data() const {
+		return buf.data();
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> dmatrix<T>::trans(const execution pol) const {
+		dmatrix<T> res(w, h);
+		parallelFor(pol, 0, (w + 63) / 64, 1, [&](const size_t lo, const size_t hi) {
+			const size_t c0 = lo * 64, c1 = std::min(w, hi * 64);
+			transKernel(buf.data() + c0, w, res.data() + c0 * h, h, h, c1 - c0);
+		});
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::transpose(const execution pol) {
+		if (h == w) transInPlace(buf.data(), w, w, pol);
+		else *this = trans(pol);
+		return *this;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const transView<dmatrix<T>> dmatrix<T>::t() const {
+		return transView<dmatrix<T>>(*this);
+	}
+	template<typename T>
+	template<typename F>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::map(F&& f, const execution pol) const {
+		constexpr bool indexed = std::is_invocable_v<F&, const T&, size_t, size_t>;
+		using U = std::decay_t<typename std::conditional_t<indexed, std::invoke_result<F&, const T&, size_t, size_t>, std::invoke_result<F&, const T&>>::type>;
+		dmatrix<U> res(h, w);
+		parallelFor(pol, 0, h * w, 4096, [&](const size_t lo, const size_t hi) {
+			U* out = res.data();
+			for (size_t k = lo; k < hi; k++) {
+				if constexpr (indexed) out[k] = f(buf[k], k / w, k % w);
+				else out[k] = f(buf[k]);
+			}
+		});
+		return res;
+	}
+	template<typename T>
+	template<typename U, typename F>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::zipMap(const dmatrix<U>& x, F&& f, const execution pol) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		using V = std::decay_t<std::invoke_result_t<F&, const T&, const U&>>;
+		dmatrix<V> res(h, w);
+		parallelFor(pol, 0, h * w, 4096, [&](const size_t lo, const size_t hi) {
+			const U* b = x.data();
+			V* out = res.data();
+			for (size_t k = lo; k < hi; k++)
+				out[k] = f(buf[k], b[k]);
+		});
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const T dmatrix<T>::sum(const execution pol) const {
+		using A = typename accumType<T>::type;
+		const T* a = data();
+		return T(parallelReduce(pol, 0, h * w, 4096, A{}, [&](const size_t lo, const size_t hi) {
+			return pairwiseSum<A>(lo, hi, [&](const size_t k) { return A(a[k]); });
+		}, std::plus<A>()));
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const T dmatrix<T>::min(const execution pol) const {
+		if (buf.empty()) throw dimension_mismatch();
+		auto lesser = [](const T& a, const T& b) { return b < a ? b : a; };
+		return parallelReduce(pol, 0, h * w, 4096, buf[0], [&](const size_t lo, const size_t hi) {
+			T res = buf[lo];
+			for (size_t k = lo + 1; k < hi; k++)
+				res = lesser(res, buf[k]);
+			return res;
+		}, lesser);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const T dmatrix<T>::max(const execution pol) const {
+		if (buf.empty()) throw dimension_mismatch();
+		auto greater = [](const T& a, const T& b) { return a < b ? b : a; };
+		return parallelReduce(pol, 0, h * w, 4096, buf[0], [&](const size_t lo, const size_t hi) {
+			T res = buf[lo];
+			for (size_t k = lo + 1; k < hi; k++)
+				res = greater(res, buf[k]);
+			return res;
+		}, greater);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::norm(const execution pol) const {
+		using std::abs;
+		using std::sqrt;
+		using V = typename accumType<std::decay_t<decltype(abs(std::declval<const T&>()))>>::type;
+		const T* a = data();
+		return sqrt(parallelReduce(pol, 0, h * w, 4096, V{}, [&](const size_t lo, const size_t hi) {
+			return pairwiseSum<V>(lo, hi, [&](const size_t k) { const V x = abs(a[k]); return x * x; });
+		}, std::plus<V>()));
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const T dmatrix<T>::trace() const {
+		if (h != w) throw non_square_matrix();
+		using A = typename accumType<T>::type;
+		return T(pairwiseSum<A>(0, h, [&](const size_t k) { return A(buf[k * w + k]); }));
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::dot(const dmatrix<U>& x, const execution pol) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		using V = decltype(T() * U());
+		const T* a = data();
+		const U* b = x.data();
+		return parallelReduce(pol, 0, h * w, 4096, V{}, [&](const size_t lo, const size_t hi) {
+			return pairwiseSum<V>(lo, hi, [&](const size_t k) { return a[k] * b[k]; });
+		}, std::plus<V>());
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::mul(const dmatrix<U>& x, const execution pol) const {
+		if (w != x.height()) throw dimension_mismatch();
+		using V = std::remove_cv_t<decltype(T()* U())>;
+		if constexpr (std::is_arithmetic_v<V>) {
+			const size_t n = strassenCrossover();
+			if (n && std::min({ h, w, x.width() }) >= 2 * n) return strassen(x, n, pol);
+		}
+		if constexpr (isComplex<T>::value && isComplex<U>::value) {
+			// Interleaved complex products do not vectorize, so larger ones go through split storage.
+			if (std::min({ h, w, x.width() }) >= 16)
+				return cmatrix<typename cxType<T>::base>(*this).mul(cmatrix<typename cxType<U>::base>(x), pol).eval();
+		}
+		dmatrix<V> res(h, x.width());
+		if constexpr (isWideInt<V>::value && std::is_same_v<T, V> && std::is_same_v<U, V>) {
+			wideGemm(data(), x.data(), res.data(), h, w, x.width(), pol);
+			return res;
+		}
+		gemmKernel(data(), w, x.data(), x.width(), res.data(), res.width(), h, w, x.width(), pol);
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::strassen(const dmatrix<U>& x, const size_t leaf, const execution pol) const {
+		if (w != x.height()) throw dimension_mismatch();
+		using V = decltype(T()* U());
+		const size_t n = x.width(), cut = std::max<size_t>(leaf, 1);
+		size_t levels = 0;
+		while ((h >> levels) >= 2 * cut && (w >> levels) >= 2 * cut && (n >> levels) >= 2 * cut)
+			levels++;
+		const size_t s = (size_t)1 << levels;
+		const size_t hp = (h + s - 1) / s * s, wp = (w + s - 1) / s * s, np = (n + s - 1) / s * s;
+		dmatrix<V> res(h, n);
+		if constexpr (std::is_same_v<T, V> && std::is_same_v<U, V>) {
+			if (hp == h && wp == w && np == n) {
+				std::vector<V> arena(strassenArena(h, w, n, levels));
+				strassenKernel(data(), w, x.data(), n, res.data(), n, h, w, n, levels, arena.data(), pol);
+				return res;
+			}
+		}
+		std::vector<V> arena(hp * wp + wp * np + hp * np + strassenArena(hp, wp, np, levels), V(0));
+		V* a = arena.data(), * b = a + hp * wp, * c = b + wp * np;
+		for (size_t i = 0; i < h; i++)
+			std::copy(buf.begin() + i * w, buf.begin() + (i + 1) * w, a + i * wp);
+		for (size_t i = 0; i < w; i++)
+			std::copy(x[i], x[i] + n, b + i * np);
+		strassenKernel(a, wp, b, np, c, np, hp, wp, np, levels, c + hp * np, pol);
+		for (size_t i = 0; i < h; i++)
+			std::copy(c + i * np, c + i * np + n, res[i]);
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::mul(const transView<dmatrix<U>>& x, const execution pol) const {
+		const dmatrix<U>& b = x.base();
+		if (w != b.width()) throw dimension_mismatch();
+		using V = decltype(T()* U());
+		constexpr size_t tile = 64;
+		dmatrix<V> res(h, b.height());
+		parallelFor2d(pol, h, b.height(), tile, [&](const size_t r0, const size_t r1, const size_t c0, const size_t c1) {
+			for (size_t i = r0; i < r1; i++) {
+				const T* a = (*this)[i];
+				for (size_t j = c0; j < c1; j++) {
+					const U* r = b[j];
+					V s = 0;
+					for (size_t k = 0; k < w; k++)
+						s += a[k] * r[k];
+					res[i][j] = s;
+				}
+			}
+		});
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const T dmatrix<T>::det(const execution pol) const {
+		if (h != w) throw non_square_matrix();
+		// Bareiss needs twice the width of the largest minor; the modular path only needs the determinant itself to fit.
+		if constexpr (isExactType<T>::value) return detCRT(*this, pol);
+		else {
+			dmatrix<T> tmp = *this;
+			T res = 1;
+			for (size_t i = 0; i < h; i++) {
+				size_t piv = i;
+				for (size_t j = i + 1; j < h; j++)
+					if (abs(tmp[j][i]) > abs(tmp[piv][i])) piv = j;
+				if (tmp[piv][i] == 0) return 0;
+				if (piv != i) {
+					std::swap_ranges(tmp[i] + i, tmp[i] + w, tmp[piv] + i);
+					res = 0 - res;
+				}
+				const T* p = tmp[i];
+				res *= p[i];
+				parallelFor(pol, i + 1, h, std::max<size_t>(1, 16384 / (w - i)), [&](const size_t lo, const size_t hi) {
+					for (size_t j = lo; j < hi; j++) {
+						T* r = tmp[j];
+						const T d = r[i] / p[i];
+						for (size_t k = i; k < w; k++)
+							r[k] -= p[k] * d;
+					}
+				});
+			}
+			return res;
+		}
+	}
+
+	template<typename T>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void dmatrix<T>::apply(const std::vector<U>& x, std::vector<V>& y, const execution pol) const {
+		if (x.size() != w) throw dimension_mismatch();
+		y.resize(h);
+		parallelFor(pol, 0, h, std::max<size_t>(1, 4096 / (w + 1)), [&](const size_t lo, const size_t hi) {
+			for (size_t i = lo; i < hi; i++) {
+				const T* r = (*this)[i];
+				V s = 0;
+				for (size_t j = 0; j < w; j++)
+					s += r[j] * x[j];
+				y[i] = s;
+			}
+		});
+	}
+
+	template<typename T>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void dmatrix<T>::applyTrans(const std::vector<U>& x, std::vector<V>& y, const execution pol) const {
+		if (x.size() != h) throw dimension_mismatch();
+		y.assign(w, V(0));
+		parallelFor(pol, 0, w, 1024, [&](const size_t lo, const size_t hi) {
+			for (size_t k = 0; k < h; k++) {
+				const T* r = (*this)[k];
+				for (size_t i = lo; i < hi; i++)
+					y[i] += r[i] * x[k];
+			}
+		});
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline T* dmatrix<T>::operator[](const size_t& h) {
+		return buf.data() + h * w;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const T* dmatrix<T>::operator[](const size_t& h) const {
+		return buf.data() + h * w;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline T& dmatrix<T>::operator()(const size_t& i, const size_t& j) {
+		return buf[i * w + j];
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const T& dmatrix<T>::operator()(const size_t& i, const size_t& j) const {
+		return buf[i * w + j];
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool dmatrix<T>::operator==(const dmatrix<U>& x) const {
+		if (h != x.height() || w != x.width()) return false;
+		const U* o = x.data();
+		for (size_t k = 0; k < h * w; k++)
+			if (buf[k] != o[k]) return false;
+		return true;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool dmatrix<T>::operator!=(const dmatrix<U>& x) const {
+		return !(*this == x);
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator=(const dmatrix<U>& x) {
+		h = x.height();
+		w = x.width();
+		buf.assign(x.data(), x.data() + h * w);
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator+=(const dmatrix<U>& x) {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		const U* o = x.data();
+		for (size_t k = 0; k < h * w; k++)
+			buf[k] += o[k];
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator-=(const dmatrix<U>& x) {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		const U* o = x.data();
+		for (size_t k = 0; k < h * w; k++)
+			buf[k] -= o[k];
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator*=(const U& x) {
+		for (auto& e : buf)
+			e *= x;
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator*=(const dmatrix<U>& x) {
+		return *this = mul(x);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator/=(const U& x) {
+		for (auto& e : buf)
+			e /= x;
+		return *this;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator+(const dmatrix<U>& x) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		using V = decltype(T() + U());
+		dmatrix<V> res(h, w);
+		V* out = res.data();
+		const U* o = x.data();
+		for (size_t k = 0; k < h * w; k++)
+			out[k] = buf[k] + o[k];
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator-(const dmatrix<U>& x) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		using V = decltype(T() - U());
+		dmatrix<V> res(h, w);
+		V* out = res.data();
+		const U* o = x.data();
+		for (size_t k = 0; k < h * w; k++)
+			out[k] = buf[k] - o[k];
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator*(const U& x) const {
+		using V = decltype(T()* U());
+		dmatrix<V> res(h, w);
+		V* out = res.data();
+		for (size_t k = 0; k < h * w; k++)
+			out[k] = buf[k] * x;
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator*(const dmatrix<U>& x) const {
+		return mul(x);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator*(const transView<dmatrix<U>>& x) const {
+		return mul(x);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator/(const U& x) const {
+		using V = decltype(T() / U());
+		dmatrix<V> res(h, w);
+		V* out = res.data();
+		for (size_t k = 0; k < h * w; k++)
+			out[k] = buf[k] / x;
+		return res;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> dmatrix<T>::idMatrix(const size_t n) {
+		dmatrix<T> res(n, n);
+		for (size_t i = 0; i < n; i++)
+			res[i][i] = 1;
+		return res;
+	}
+
+	template<typename U, typename T> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const U& x, const dmatrix<T>& m) {
+		using V = decltype(U()* T());
+		dmatrix<V> res(m.height(), m.width());
+		V* out = res.data();
+		const T* in = m.data();
+		for (size_t k = 0; k < m.height() * m.width(); k++)
+			out[k] = x * in[k];
+		return res;
+	}
+
+	template<typename T, typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const transView<dmatrix<T>>& x, const dmatrix<U>& m) {
+		const dmatrix<T>& a = x.base();
+		if (a.height() != m.height()) throw dimension_mismatch();
+		using V = decltype(T()* U());
+		dmatrix<V> res(a.width(), m.width());
+		for (size_t k = 0; k < a.height(); k++) {
+			const T* r = a[k];
+			const U* b = m[k];
+			for (size_t i = 0; i < a.width(); i++) {
+				const V aki = r[i];
+				V* out = res[i];
+				for (size_t j = 0; j < m.width(); j++)
+					out[j] += aki * b[j];
+			}
+		}
+		return res;
+	}
+}
@@ -0,0 +1,244 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "exact.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace math {
+
+	template<typename T>
+	static inline const uint64_t residue(const T& x, const uint32_t p) {
+		if constexpr (std::is_signed_v<T>) {
+			const long long r = (long long)(x % (long long)p);
+			return (uint64_t)(r < 0 ? r + p : r);
+		}
+		else {
+			const bool neg = isNegative(x);
+			const uint64_t r = (uint64_t)((neg ? T(0) - x : x) % T(p));
+			return neg && r ? p - r : r;
+		}
+	}
+	static inline const bool isPrime32(const uint32_t n) {
+		if (n < 2) return false;
+		for (const uint32_t q : { 2u, 3u, 5u, 7u })
+			if (n % q == 0) return n == q;
+		uint64_t d = n - 1;
+		size_t s = 0;
+		for (; !(d & 1); s++)
+			d >>= 1;
+		for (const uint64_t a : { 2ull, 7ull, 61ull }) {
+			if (a % n == 0) continue;
+			uint64_t x = powMod(a, d, n);
+			if (x == 1 || x == n - 1) continue;
+			size_t r = 1;
+			for (; r < s; r++)
+				if ((x = x * x % n) == n - 1) break;
+			if (r == s) return false;
+		}
+		return true;
+	}
+	template<typename T>
+	static inline const size_t bitLength(const T& x) {
+		T m = isNegative(x) ? T(0) - x : x;
+		size_t n = 0;
+		for (; m != T(0); n++)
+			m = m >> 1;
+		return n;
+	}
+
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto bareiss(M a, const execution pol) {
+		using T = std::decay_t<decltype(a(0, 0))>;
+		static_assert(isExactType<T>::value, "math::bareiss requires an integer element type.");
+		if (a.height() != a.width()) throw non_square_matrix();
+		const size_t n = a.height();
+		if (n == 0) return T(1);
+		T prev = 1;
+		bool neg = false;
+		for (size_t k = 0; k + 1 < n; k++) {
+			size_t piv = k;
+			while (piv < n && a(piv, k) == T(0))
+				piv++;
+			if (piv == n) return T(0);
+			if (piv != k) {
+				for (size_t j = k; j < n; j++)
+					std::swap(a(k, j), a(piv, j));
+				neg = !neg;
+			}
+			// Every quotient is a minor of the input, so the division by the previous pivot is exact.
+			parallelFor(pol, k + 1, n, std::max<size_t>(1, 1024 / (n - k)), [&](const size_t lo, const size_t hi) {
+				for (size_t i = lo; i < hi; i++)
+					for (size_t j = k + 1; j < n; j++)
+						a(i, j) = sdiv(T(a(i, j) * a(k, k) - a(i, k) * a(k, j)), prev);
+			});
+			prev = a(k, k);
+		}
+		return neg ? T(0) - a(n - 1, n - 1) : a(n - 1, n - 1);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const exactSolution<T> bareissSolve(const dmatrix<T>& a, const std::vector<T>& b) {
+		static_assert(isExactType<T>::value, "math::bareissSolve requires an integer element type.");
+		if (a.height() != a.width()) throw non_square_matrix();
+		const size_t n = a.height();
+		if (b.size() != n) throw dimension_mismatch();
+		dmatrix<T> m(n, n + 1);
+		for (size_t i = 0; i < n; i++) {
+			std::copy(a[i], a[i] + n, m[i]);
+			m(i, n) = b[i];
+		}
+		T prev = 1;
+		for (size_t k = 0; k < n; k++) {
+			size_t piv = k;
+			while (piv < n && m(piv, k) == T(0))
+				piv++;
+			if (piv == n) throw singular_matrix();
+			if (piv != k) std::swap_ranges(m[k] + k, m[k] + n + 1, m[piv] + k);
+			for (size_t i = k + 1; i < n; i++)
+				for (size_t j = k + 1; j <= n; j++)
+					m(i, j) = sdiv(T(m(i, j) * m(k, k) - m(i, k) * m(k, j)), prev);
+			prev = m(k, k);
+		}
+		exactSolution<T> res{ std::vector<T>(n), prev };
+		for (size_t i = n; i-- > 0;) {
+			T s = prev * m(i, n);
+			for (size_t j = i + 1; j < n; j++)
+				s = s - m(i, j) * res.num[j];
+			res.num[i] = sdiv(s, m(i, i));
+		}
+		return res;
+	}
+
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] const uint32_t detMod(const M& a, const uint32_t p) {
+		if (a.height() != a.width()) throw non_square_matrix();
+		const size_t n = a.height();
+		std::vector<uint64_t> m(n * n);
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = 0; j < n; j++)
+				m[i * n + j] = residue(a(i, j), p);
+		uint64_t res = 1 % p;
+		for (size_t k = 0; k < n; k++) {
+			size_t piv = k;
+			while (piv < n && m[piv * n + k] == 0)
+				piv++;
+			if (piv == n) return 0;
+			if (piv != k) {
+				std::swap_ranges(m.begin() + k * n + k, m.begin() + (k + 1) * n, m.begin() + piv * n + k);
+				res = res ? p - res : 0;
+			}
+			const uint64_t* r = &m[k * n];
+			res = res * r[k] % p;
+			const uint64_t inv = powMod(r[k], p - 2, p);
+			for (size_t i = k + 1; i < n; i++) {
+				uint64_t* s = &m[i * n];
+				const uint64_t f = s[k] * inv % p;
+				if (f == 0) continue;
+				for (size_t j = k + 1; j < n; j++)
+					s[j] = (s[j] + (p - f) * r[j] % p) % p;
+			}
+		}
+		return (uint32_t)res;
+	}
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto detCRT(const M& a, const execution pol) {
+		using T = std::decay_t<decltype(a(0, 0))>;
+		static_assert(isExactType<T>::value, "math::detCRT requires an integer element type.");
+		if (a.height() != a.width()) throw non_square_matrix();
+		const size_t n = a.height();
+		// Hadamard's bound |det| <= prod ||row|| <= prod sqrt(n) max|a_ij| fixes how many primes are needed.
+		size_t bits = 2, lg = 0;
+		while (((size_t)1 << lg) < n)
+			lg++;
+		for (size_t i = 0; i < n; i++) {
+			size_t row = 0;
+			for (size_t j = 0; j < n; j++)
+				row = std::max(row, bitLength(a(i, j)));
+			bits += row + (lg + 1) / 2;
+		}
+		// Narrow types reconstruct in 64 bits, so their determinant is exact whenever it fits in T.
+		using W = std::conditional_t<(sizeof(T) < sizeof(int64_t)), int64_t, T>;
+		const size_t cap = std::max<size_t>(1, (8 * sizeof(W) - 2) / 31);
+		const size_t count = std::min(cap, (bits + 29) / 30);
+		std::vector<uint32_t> primes;
+		for (uint32_t q = 0x7FFFFFFF; primes.size() < count; q -= 2)
+			if (isPrime32(q)) primes.push_back(q);
+		std::vector<uint32_t> rem(count);
+		parallelFor(pol, 0, count, 1, [&](const size_t lo, const size_t hi) {
+			for (size_t k = lo; k < hi; k++)
+				rem[k] = detMod(a, primes[k]);
+		});
+		// Garner's mixed-radix reconstruction keeps every intermediate below the running modulus.
+		W x = W(rem[0]), mod = W(primes[0]);
+		for (size_t k = 1; k < count; k++) {
+			const uint64_t q = primes[k], xm = residue(x, primes[k]), mm = residue(mod, primes[k]);
+			const uint64_t t = (rem[k] + q - xm) % q * powMod(mm, q - 2, q) % q;
+			x = x + mod * W(t);
+			mod = mod * W(q);
+		}
+		return T(mod - x < x ? x - mod : x);
+	}
+
+	template<typename T, typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<uint32_t> mulMod(const dmatrix<T>& a, const dmatrix<U>& b, const uint32_t p, const execution pol) {
+		if (a.width() != b.height()) throw dimension_mismatch();
+		const size_t m = a.height(), k = a.width(), n = b.width();
+		std::vector<uint32_t> ra(m * k), rb(n * k);
+		for (size_t i = 0; i < m; i++)
+			for (size_t l = 0; l < k; l++)
+				ra[i * k + l] = (uint32_t)residue(a(i, l), p);
+		for (size_t l = 0; l < k; l++)
+			for (size_t j = 0; j < n; j++)
+				rb[j * k + l] = (uint32_t)residue(b(l, j), p);
+		const uint64_t wrap = powMod(2, 64, p);
+		dmatrix<uint32_t> res(m, n);
+		parallelFor(pol, 0, m, 1, [&](const size_t lo, const size_t hi) {
+			for (size_t i = lo; i < hi; i++) {
+				const uint32_t* x = &ra[i * k];
+				for (size_t j = 0; j < n; j++) {
+					const uint32_t* y = &rb[j * k];
+					// Products stay below 2^64, so carries out of the accumulator are counted and reduced once per entry.
+					uint64_t acc = 0, carry = 0;
+					for (size_t l = 0; l < k; l++) {
+						const uint64_t s = (uint64_t)x[l] * y[l];
+						acc += s;
+						carry += acc < s;
+					}
+					res(i, j) = (uint32_t)((carry % p * wrap + acc % p) % p);
+				}
+			}
+		});
+		return res;
+	}
+}
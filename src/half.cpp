@@ -0,0 +1,221 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "half.h"
+
+#include <string.h>
+
+#if defined(__F16C__) || defined(__AVX2__) || defined(__AVX512BF16__)
+#include <immintrin.h>
+#endif
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define _HF_F16C_
+#endif // F16C
+#ifdef __AVX2__
+#define _HF_AVX2_
+#endif // __AVX2__
+#if defined(__AVX512BF16__) && defined(__AVX512VL__)
+#define _HF_BF16_
+#endif // AVX-512 BF16
+
+namespace math {
+
+	static inline const uint32_t floatBits(const float x) {
+		uint32_t b;
+		memcpy(&b, &x, sizeof(b));
+		return b;
+	}
+	static inline const float bitsFloat(const uint32_t b) {
+		float x;
+		memcpy(&x, &b, sizeof(x));
+		return x;
+	}
+
+	static inline const uint16_t halfFromFloat(const float f) {
+#ifdef _HF_F16C_
+		return (uint16_t)_cvtss_sh(f, 0);
+#else
+		uint32_t x = floatBits(f);
+		const uint16_t sign = (uint16_t)((x >> 16) & 0x8000);
+		x &= 0x7FFFFFFF;
+		if (x >= 0x7F800000) return sign | 0x7C00 | (x > 0x7F800000 ? 0x200 : 0);
+		if (x >= 0x477FF000) return sign | 0x7C00;
+		if (x < 0x33000000) return sign;
+		uint32_t m, rem, half;
+		if (x < 0x38800000) {
+			const uint32_t shift = 126 - (x >> 23), mant = (x & 0x7FFFFF) | 0x800000;
+			m = mant >> shift;
+			rem = mant & ((1u << shift) - 1);
+			half = 1u << (shift - 1);
+		}
+		else {
+			x -= 0x38000000;
+			m = x >> 13;
+			rem = x & 0x1FFF;
+			half = 0x1000;
+		}
+		if (rem > half || (rem == half && (m & 1))) m++;
+		return sign | (uint16_t)m;
+#endif // _HF_F16C_
+	}
+	static inline const float halfToFloat(const uint16_t h) {
+#ifdef _HF_F16C_
+		return _cvtsh_ss(h);
+#else
+		const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+		uint32_t e = (h >> 10) & 0x1F, m = h & 0x3FF;
+		if (e == 0x1F) return bitsFloat(sign | 0x7F800000 | (m << 13));
+		if (e) return bitsFloat(sign | ((e + 112) << 23) | (m << 13));
+		if (m == 0) return bitsFloat(sign);
+		for (e = 113; !(m & 0x400); e--)
+			m <<= 1;
+		return bitsFloat(sign | (e << 23) | ((m & 0x3FF) << 13));
+#endif // _HF_F16C_
+	}
+
+	static inline const uint16_t bhalfFromFloat(const float f) {
+		const uint32_t x = floatBits(f);
+		if ((x & 0x7FFFFFFF) > 0x7F800000) return (uint16_t)((x >> 16) | 0x40);
+		return (uint16_t)((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+	}
+	static inline const float bhalfToFloat(const uint16_t h) {
+		return bitsFloat((uint32_t)h << 16);
+	}
+
+	MATHPLUSPLUS_API constexpr float16::float16() : bits(0) {}
+	MATHPLUSPLUS_API float16::float16(const float x) : bits(halfFromFloat(x)) {}
+
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const float16 float16::fromBits(const uint16_t b) {
+		float16 res;
+		res.bits = b;
+		return res;
+	}
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint16_t float16::raw() const {
+		return bits;
+	}
+
+	MATHPLUSPLUS_API float16::operator float() const {
+		return halfToFloat(bits);
+	}
+
+	MATHPLUSPLUS_API float16& float16::operator+=(const float x) {
+		return *this = float16(float(*this) + x);
+	}
+	MATHPLUSPLUS_API float16& float16::operator-=(const float x) {
+		return *this = float16(float(*this) - x);
+	}
+	MATHPLUSPLUS_API float16& float16::operator*=(const float x) {
+		return *this = float16(float(*this) * x);
+	}
+	MATHPLUSPLUS_API float16& float16::operator/=(const float x) {
+		return *this = float16(float(*this) / x);
+	}
+
+	MATHPLUSPLUS_API constexpr bfloat16::bfloat16() : bits(0) {}
+	MATHPLUSPLUS_API bfloat16::bfloat16(const float x) : bits(bhalfFromFloat(x)) {}
+
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bfloat16 bfloat16::fromBits(const uint16_t b) {
+		bfloat16 res;
+		res.bits = b;
+		return res;
+	}
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint16_t bfloat16::raw() const {
+		return bits;
+	}
+
+	MATHPLUSPLUS_API bfloat16::operator float() const {
+		return bhalfToFloat(bits);
+	}
+
+	MATHPLUSPLUS_API bfloat16& bfloat16::operator+=(const float x) {
+		return *this = bfloat16(float(*this) + x);
+	}
+	MATHPLUSPLUS_API bfloat16& bfloat16::operator-=(const float x) {
+		return *this = bfloat16(float(*this) - x);
+	}
+	MATHPLUSPLUS_API bfloat16& bfloat16::operator*=(const float x) {
+		return *this = bfloat16(float(*this) * x);
+	}
+	MATHPLUSPLUS_API bfloat16& bfloat16::operator/=(const float x) {
+		return *this = bfloat16(float(*this) / x);
+	}
+
+	MATHPLUSPLUS_API void toFloat(const float16* x, float* y, const size_t n) {
+		size_t k = 0;
+#ifdef _HF_F16C_
+		for (; k + 8 <= n; k += 8)
+			_mm256_storeu_ps(y + k, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(x + k))));
+#endif // _HF_F16C_
+		for (; k < n; k++)
+			y[k] = halfToFloat(x[k].raw());
+	}
+	MATHPLUSPLUS_API void toFloat(const bfloat16* x, float* y, const size_t n) {
+		size_t k = 0;
+#ifdef _HF_AVX2_
+		for (; k + 8 <= n; k += 8) {
+			const __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(x + k)));
+			_mm256_storeu_ps(y + k, _mm256_castsi256_ps(_mm256_slli_epi32(v, 16)));
+		}
+#endif // _HF_AVX2_
+		for (; k < n; k++)
+			y[k] = bhalfToFloat(x[k].raw());
+	}
+	MATHPLUSPLUS_API void fromFloat(const float* x, float16* y, const size_t n) {
+		size_t k = 0;
+#ifdef _HF_F16C_
+		for (; k + 8 <= n; k += 8)
+			_mm_storeu_si128((__m128i*)(y + k), _mm256_cvtps_ph(_mm256_loadu_ps(x + k), _MM_FROUND_TO_NEAREST_INT));
+#endif // _HF_F16C_
+		for (; k < n; k++)
+			y[k] = float16(x[k]);
+	}
+	MATHPLUSPLUS_API void fromFloat(const float* x, bfloat16* y, const size_t n) {
+		size_t k = 0;
+#if defined(_HF_BF16_)
+		for (; k + 8 <= n; k += 8)
+			_mm_storeu_si128((__m128i*)(y + k), (__m128i)_mm256_cvtneps_pbh(_mm256_loadu_ps(x + k)));
+#elif defined(_HF_AVX2_)
+		const __m256i one = _mm256_set1_epi32(1), bias = _mm256_set1_epi32(0x7FFF), quiet = _mm256_set1_epi32(0x40);
+		for (; k + 8 <= n; k += 8) {
+			const __m256 f = _mm256_loadu_ps(x + k);
+			const __m256i v = _mm256_castps_si256(f), hi = _mm256_srli_epi32(v, 16);
+			const __m256i r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(v, bias), _mm256_and_si256(hi, one)), 16);
+			const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q));
+			const __m256i b = _mm256_blendv_epi8(r, _mm256_or_si256(hi, quiet), nan);
+			const __m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi32(b, b), 0x08);
+			_mm_storeu_si128((__m128i*)(y + k), _mm256_castsi256_si128(p));
+		}
+#endif // BF16
+		for (; k < n; k++)
+			y[k] = bfloat16(x[k]);
+	}
+}
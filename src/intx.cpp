@@ -35,8 +35,82 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <stdint.h>
 #include <exception>
+#include <type_traits>
 
 namespace math {
+
+	template<size_t _N>
+	static constexpr inline void limbShl(std::array<uint32_t, _N>& a, const int n) {
+		const size_t q = (size_t)n / 32, r = (size_t)n % 32;
+		for (size_t i = 0; i < _N; i++) {
+			const uint32_t hi = i + q < _N ? a[i + q] : 0, lo = i + q + 1 < _N ? a[i + q + 1] : 0;
+			a[i] = r ? (hi << r) | (lo >> (32 - r)) : hi;
+		}
+	}
+	template<size_t _N>
+	static constexpr inline void limbShr(std::array<uint32_t, _N>& a, const int n) {
+		const size_t q = (size_t)n / 32, r = (size_t)n % 32;
+		for (size_t i = _N; i-- > 0;) {
+			const uint32_t lo = i >= q ? a[i - q] : 0, hi = i >= q + 1 ? a[i - q - 1] : 0;
+			a[i] = r ? (lo >> r) | (hi << (32 - r)) : lo;
+		}
+	}
+	template<size_t _N>
+	MATHPLUSPLUS_API constexpr inline const uint32_t limbAdd(std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b) {
+		uint64_t c = 0;
+		for (size_t i = _N; i-- > 0;) {
+			c += (uint64_t)a[i] + b[i];
+			a[i] = (uint32_t)c;
+			c >>= 32;
+		}
+		return (uint32_t)c;
+	}
+	template<size_t _N>
+	MATHPLUSPLUS_API constexpr inline const uint32_t limbSub(std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b) {
+		uint64_t borrow = 0;
+		for (size_t i = _N; i-- > 0;) {
+			const uint64_t d = (uint64_t)a[i] - b[i] - borrow;
+			a[i] = (uint32_t)d;
+			borrow = d >> 63;
+		}
+		return (uint32_t)borrow;
+	}
+	template<size_t _N>
+	static constexpr inline void limbMul(std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b) {
+		std::array<uint32_t, _N> r{};
+		for (size_t i = 0; i < _N; i++) {
+			const uint64_t ai = a[_N - 1 - i];
+			uint64_t c = 0;
+			for (size_t j = 0; i + j < _N; j++) {
+				c += ai * b[_N - 1 - j] + r[_N - 1 - i - j];
+				r[_N - 1 - i - j] = (uint32_t)c;
+				c >>= 32;
+			}
+		}
+		a = r;
+	}
+	template<size_t _N>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool limbLess(const std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b) {
+		for (size_t i = 0; i < _N; i++)
+			if (a[i] != b[i]) return a[i] < b[i];
+		return false;
+	}
+	template<size_t _N>
+	static constexpr inline void limbDivMod(std::array<uint32_t, _N>& a, const std::array<uint32_t, _N>& b, const bool quotient) {
+		std::array<uint32_t, _N> q{}, r{};
+		size_t top = 0;
+		while (top < _N && a[top] == 0)
+			top++;
+		for (size_t bit = (_N - top) * 32; bit-- > 0;) {
+			limbShl(r, 1);
+			r[_N - 1] |= (a[_N - 1 - bit / 32] >> (bit % 32)) & 1;
+			if (!limbLess(r, b)) {
+				limbSub(r, b);
+				q[_N - 1 - bit / 32] |= 1u << (bit % 32);
+			}
+		}
+		a = quotient ? q : r;
+	}
 	
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint32_t uint128_t::operator[](int16_t n) const {
 		return 0 <= n && n < 4 ? buf[n] : 0;
@@ -98,101 +172,32 @@ namespace math {
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint128_t& uint128_t::operator>>=(const int& n) {
-		for (short i = 0; i < 4; i++)
-			buf[i] = (buf[i - (n >> 3)] >> (n % 8)) | (buf[i + 1 - (n >> 3)] << (8 - (n % 8)));
+		limbShr(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint128_t& uint128_t::operator<<=(const int& n) {
-		for (short i = 0; i < 4; i++)
-			buf[i] = (buf[i + (n >> 3)] << (n % 8)) | (buf[i + 1 + (n >> 3)] >> (8 - (n % 8)));
+		limbShl(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint128_t& uint128_t::operator+=(const uint128_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 3; i >= 0; i--) {
-			tmp += buf[i] + x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbAdd(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint128_t& uint128_t::operator-=(const uint128_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 3; i >= 0; i--) {
-			tmp = tmp + 0xffffffff + buf[i] - x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbSub(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint128_t& uint128_t::operator*=(const uint128_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 3; i >= 0; i--) {
-			for (short j = 0; j <= i; j++)
-				tmp += (uint64_t)buf[3 - j] * (uint64_t)x[3 - i + j];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbMul(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint128_t& uint128_t::operator/=(const uint128_t& x) {
-		uint128_t res, one = 1;
-		int16_t s = 0, m = 63, e = 127;
-		while (e > 0) {
-			uint128_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = res | (one << m);
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		return *this = res;
+		limbDivMod(buf, x.buf, true);
+		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint128_t& uint128_t::operator%=(const uint128_t& x) {
-		uint128_t res, one = 1;
-		int16_t s = 0, m = 63, e = 127;
-		while (e > 0) {
-			uint128_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = 0;
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		res *= x;
-		return *this -= res;
+		limbDivMod(buf, x.buf, false);
+		return *this;
 	}
 
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint128_t uint128_t::operator|(const uint128_t& x) const {
@@ -316,101 +321,32 @@ namespace math {
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint256_t& uint256_t::operator>>=(const int& n) {
-		for (short i = 0; i < 8; i++)
-			buf[i] = (buf[i - (n >> 3)] >> (n % 8)) | (buf[i + 1 - (n >> 3)] << (8 - (n % 8)));
+		limbShr(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint256_t& uint256_t::operator<<=(const int& n) {
-		for (short i = 0; i < 8; i++)
-			buf[i] = (buf[i + (n >> 3)] << (n % 8)) | (buf[i + 1 + (n >> 3)] >> (8 - (n % 8)));
+		limbShl(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint256_t& uint256_t::operator+=(const uint256_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 7; i >= 0; i--) {
-			tmp += buf[i] + x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbAdd(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint256_t& uint256_t::operator-=(const uint256_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 7; i >= 0; i--) {
-			tmp = tmp + 0xffffffff + buf[i] - x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbSub(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint256_t& uint256_t::operator*=(const uint256_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 7; i >= 0; i--) {
-			for (short j = 0; j <= i; j++)
-				tmp += (uint64_t)buf[7 - j] * (uint64_t)x[7 - i + j];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbMul(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint256_t& uint256_t::operator/=(const uint256_t& x) {
-		uint256_t res, one = 1;
-		int16_t s = 0, m = 127, e = 255;
-		while (e > 0) {
-			uint256_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = res | (one << m);
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		return *this = res;
+		limbDivMod(buf, x.buf, true);
+		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint256_t& uint256_t::operator%=(const uint256_t& x) {
-		uint256_t res, one = 1;
-		int16_t s = 0, m = 127, e = 255;
-		while (e > 0) {
-			uint256_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = 0;
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		res *= x;
-		return *this -= res;
+		limbDivMod(buf, x.buf, false);
+		return *this;
 	}
 
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint256_t uint256_t::operator|(const uint256_t& x) const {
@@ -544,101 +480,32 @@ namespace math {
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint512_t& uint512_t::operator>>=(const int& n) {
-		for (short i = 0; i < 16; i++)
-			buf[i] = (buf[i - (n >> 3)] >> (n % 8)) | (buf[i + 1 - (n >> 3)] << (8 - (n % 8)));
+		limbShr(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint512_t& uint512_t::operator<<=(const int& n) {
-		for (short i = 0; i < 16; i++)
-			buf[i] = (buf[i + (n >> 3)] << (n % 8)) | (buf[i + 1 + (n >> 3)] >> (8 - (n % 8)));
+		limbShl(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint512_t& uint512_t::operator+=(const uint512_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 15; i >= 0; i--) {
-			tmp += buf[i] + x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbAdd(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint512_t& uint512_t::operator-=(const uint512_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 15; i >= 0; i--) {
-			tmp = tmp + 0xffffffff + buf[i] - x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbSub(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint512_t& uint512_t::operator*=(const uint512_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 15; i >= 0; i--) {
-			for (short j = 0; j <= i; j++)
-				tmp += (uint64_t)buf[3 - j] * (uint64_t)x[3 - i + j];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbMul(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint512_t& uint512_t::operator/=(const uint512_t& x) {
-		uint512_t res, one = 1;
-		int16_t s = 0, m = 255, e = 511;
-		while (e > 0) {
-			uint512_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = res | (one << m);
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		return *this = res;
+		limbDivMod(buf, x.buf, true);
+		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint512_t& uint512_t::operator%=(const uint512_t& x) {
-		uint512_t res, one = 1;
-		int16_t s = 0, m = 255, e = 511;
-		while (e > 0) {
-			uint512_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = 0;
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		res *= x;
-		return *this -= res;
+		limbDivMod(buf, x.buf, false);
+		return *this;
 	}
 
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint512_t uint512_t::operator|(const uint512_t& x) const {
@@ -782,101 +649,32 @@ namespace math {
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint1024_t& uint1024_t::operator>>=(const int& n) {
-		for (short i = 0; i < 32; i++)
-			buf[i] = (buf[i - (n >> 3)] >> (n % 8)) | (buf[i + 1 - (n >> 3)] << (8 - (n % 8)));
+		limbShr(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint1024_t& uint1024_t::operator<<=(const int& n) {
-		for (short i = 0; i < 32; i++)
-			buf[i] = (buf[i + (n >> 3)] << (n % 8)) | (buf[i + 1 + (n >> 3)] >> (8 - (n % 8)));
+		limbShl(buf, n);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint1024_t& uint1024_t::operator+=(const uint1024_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 31; i >= 0; i--) {
-			tmp += buf[i] + x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbAdd(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint1024_t& uint1024_t::operator-=(const uint1024_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 31; i >= 0; i--) {
-			tmp = tmp + 0xffffffff + buf[i] - x[i];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbSub(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint1024_t& uint1024_t::operator*=(const uint1024_t& x) {
-		uint64_t tmp = 0;
-		for (short i = 31; i >= 0; i--) {
-			for (short j = 0; j <= i; j++)
-				tmp += (uint64_t)buf[3 - j] * (uint64_t)x[3 - i + j];
-			buf[i] = tmp & 0xffffffff;
-			tmp >>= 32;
-		}
+		limbMul(buf, x.buf);
 		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint1024_t& uint1024_t::operator/=(const uint1024_t& x) {
-		uint1024_t res, one = 1;
-		int16_t s = 0, m = 511, e = 1023;
-		while (e > 0) {
-			uint1024_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = res | (one << m);
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		return *this = res;
+		limbDivMod(buf, x.buf, true);
+		return *this;
 	}
 	MATHPLUSPLUS_API constexpr inline uint1024_t& uint1024_t::operator%=(const uint1024_t& x) {
-		uint1024_t res, one = 1;
-		int16_t s = 0, m = 511, e = 1023;
-		while (e > 0) {
-			uint1024_t tmp = x;
-			tmp *= res | (one << m);
-			if (tmp == x) {
-				*this = 0;
-				return *this;
-			}
-			else if (tmp < x) {
-				if (m + 1 == e) {
-					s = 0;
-					e--;
-					m = e / 2;
-					res |= one << m;
-				}
-				else {
-					s = m;
-					m = (e + s) / 2;
-				}
-			}
-			else {
-				e = m;
-				m = (e + s) / 2;
-			}
-		}
-		res *= x;
-		return *this -= res;
+		limbDivMod(buf, x.buf, false);
+		return *this;
 	}
 
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint1024_t uint1024_t::operator|(const uint1024_t& x) const {
@@ -931,7 +729,7 @@ namespace math {
 	}
 
 	MATHPLUSPLUS_API [[nodiscard]] uint1024_t::operator uint512_t() const {
-		uint256_t res;
+		uint512_t res;
 		for (short i = 0; i < 16; i++)
 			res.buf[i] = buf[i + 16];
 		return res;
@@ -954,61 +752,64 @@ namespace math {
 	MATHPLUSPLUS_API [[nodiscard]] uint1024_t::operator uint32_t() const {
 		return buf[31];
 	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool isNegative(const T& x) {
+		if constexpr (std::is_signed_v<T>) return x < 0;
+		else return (x >> (int)(8 * sizeof(T) - 1)) != T(0);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T sdiv(const T& x, const T& y) {
+		if constexpr (std::is_signed_v<T>) return x / y;
+		else {
+			const bool nx = isNegative(x), ny = isNegative(y);
+			const T q = (nx ? T(0) - x : x) / (ny ? T(0) - y : y);
+			return nx != ny ? T(0) - q : q;
+		}
+	}
 }
 
 namespace std {
 
 	MATHPLUSPLUS_API [[nodiscard]] const string to_string(const math::uint128_t& x) {
 		if (x == 0) return "0";
-		math::uint128_t tmp = x, s = 1;
-		while (s < tmp)
-			s *= 10;
+		math::uint128_t tmp = x;
 		string res = "";
 		while (tmp > 0) {
-			res += (char)(((uint32_t)(tmp / s)) + '0');
-			tmp %= s;
-			s /= 10;
+			res += (char)((uint32_t)(tmp % 10) + '0');
+			tmp /= 10;
 		}
-		return res;
+		return string(res.rbegin(), res.rend());
 	}
 	MATHPLUSPLUS_API [[nodiscard]] const string to_string(const math::uint256_t& x) {
 		if (x == 0) return "0";
-		math::uint256_t tmp = x, s = 1;
-		while (s < tmp)
-			s *= 10;
+		math::uint256_t tmp = x;
 		string res = "";
 		while (tmp > 0) {
-			res += (char)(((uint32_t)(tmp / s)) + '0');
-			tmp %= s;
-			s /= 10;
+			res += (char)((uint32_t)(tmp % 10) + '0');
+			tmp /= 10;
 		}
-		return res;
+		return string(res.rbegin(), res.rend());
 	}
 	MATHPLUSPLUS_API [[nodiscard]] const string to_string(const math::uint512_t& x) {
 		if (x == 0) return "0";
-		math::uint512_t tmp = x, s = 1;
-		while (s < tmp)
-			s *= 10;
+		math::uint512_t tmp = x;
 		string res = "";
 		while (tmp > 0) {
-			res += (char)(((uint32_t)(tmp / s)) + '0');
-			tmp %= s;
-			s /= 10;
+			res += (char)((uint32_t)(tmp % 10) + '0');
+			tmp /= 10;
 		}
-		return res;
+		return string(res.rbegin(), res.rend());
 	}
 	MATHPLUSPLUS_API [[nodiscard]] const string to_string(const math::uint1024_t& x) {
 		if (x == 0) return "0";
-		math::uint1024_t tmp = x, s = 1;
-		while (s < tmp)
-			s *= 10;
+		math::uint1024_t tmp = x;
 		string res = "";
 		while (tmp > 0) {
-			res += (char)(((uint32_t)(tmp / s)) + '0');
-			tmp %= s;
-			s /= 10;
+			res += (char)((uint32_t)(tmp % 10) + '0');
+			tmp /= 10;
 		}
-		return res;
+		return string(res.rbegin(), res.rend());
 	}
 }
 
@@ -0,0 +1,414 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "io.h"
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <limits.h>
+#endif
+
+namespace math {
+
+	MATHPLUSPLUS_API matrix_file_error::matrix_file_error(const std::string& what) : std::runtime_error(what) {}
+
+	static constexpr char fileMagic[4] = { 'M', 'P', 'P', 'M' };
+	static constexpr uint16_t byteOrder = 0x0102;
+	static constexpr size_t fileAlign = 64;
+
+	struct fileSegment {
+		const void* p;
+		size_t n;
+	};
+
+	static const size_t alignUp(const size_t x, const size_t a) {
+		return (x + a - 1) / a * a;
+	}
+
+	// Header, padding and payload go out in one gathered write, so a file is never assembled in an intermediate buffer.
+	// Only the save() templates call it, hence inline: a translation unit that instantiates none of them stays warning-free.
+	static inline void writeSegments(const std::string& path, const std::vector<fileSegment>& s) {
+#ifdef _WIN32
+		HANDLE f = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (f == INVALID_HANDLE_VALUE) throw matrix_file_error("Cannot create matrix file " + path);
+		for (const fileSegment& x : s) {
+			const char* p = (const char*)x.p;
+			for (size_t n = x.n; n > 0;) {
+				DWORD done = 0;
+				if (!WriteFile(f, p, (DWORD)std::min<size_t>(n, 1 << 30), &done, nullptr)) {
+					CloseHandle(f);
+					throw matrix_file_error("Cannot write matrix file " + path);
+				}
+				p += done;
+				n -= done;
+			}
+		}
+		CloseHandle(f);
+#else
+		const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) throw matrix_file_error("Cannot create matrix file " + path);
+		std::vector<iovec> v;
+		for (const fileSegment& x : s)
+			if (x.n) v.push_back({ const_cast<void*>(x.p), x.n });
+		size_t k = 0;
+		while (k < v.size()) {
+			const ssize_t done = ::writev(fd, v.data() + k, (int)std::min<size_t>(v.size() - k, IOV_MAX));
+			if (done < 0) {
+				::close(fd);
+				throw matrix_file_error("Cannot write matrix file " + path);
+			}
+			// Partial writes resume inside the segment where the kernel stopped.
+			for (size_t n = (size_t)done; n > 0 && k < v.size();) {
+				const size_t m = std::min(n, v[k].iov_len);
+				v[k].iov_base = (char*)v[k].iov_base + m;
+				v[k].iov_len -= m;
+				n -= m;
+				if (v[k].iov_len == 0) k++;
+			}
+		}
+		if (::close(fd) != 0) throw matrix_file_error("Cannot write matrix file " + path);
+#endif
+	}
+
+	template<typename T>
+	static const matrixFileHeader makeHeader(const storageKind kind, const size_t h, const size_t w, const bool column, const size_t stride, const size_t nnz, const size_t align) {
+		static_assert(std::is_trivially_copyable_v<T>, "math::matrix files store elements by their bytes.");
+		matrixFileHeader hdr{};
+		std::memcpy(hdr.magic, fileMagic, 4);
+		hdr.version = matrixFileHeader::currentVersion;
+		hdr.order = byteOrder;
+		hdr.type = (uint8_t)dtypeOf<T>::value;
+		hdr.kind = (uint8_t)kind;
+		hdr.column = column;
+		hdr.elemSize = (uint8_t)sizeof(T);
+		hdr.align = (uint32_t)align;
+		hdr.height = h;
+		hdr.width = w;
+		hdr.stride = stride;
+		hdr.nnz = nnz;
+		hdr.offset = alignUp(sizeof(matrixFileHeader), align);
+		return hdr;
+	}
+
+	static void checkHeader(const matrixFileHeader& hdr, const std::string& path) {
+		if (std::memcmp(hdr.magic, fileMagic, 4) != 0) throw matrix_file_error(path + " is not a matrix file");
+		if (hdr.order != byteOrder) throw matrix_file_error(path + " was written with a different byte order");
+		if (hdr.version == 0 || hdr.version > matrixFileHeader::currentVersion) throw matrix_file_error(path + " has an unsupported format version");
+	}
+
+	template<typename T>
+	static void checkType(const matrixFileHeader& hdr, const std::string& path) {
+		if (hdr.type != (uint8_t)dtypeOf<T>::value || hdr.elemSize != sizeof(T)) throw matrix_file_error(path + " holds a different element type");
+	}
+
+	static const size_t denseBytes(const matrixFileHeader& hdr) {
+		return (size_t)(hdr.column ? hdr.width : hdr.height) * hdr.stride * hdr.elemSize;
+	}
+
+	static void checkDense(const matrixFileHeader& hdr, const size_t size, const std::string& path) {
+		if (hdr.kind != (uint8_t)storageKind::dense) throw matrix_file_error(path + " does not hold a dense matrix");
+		if (hdr.offset > size) throw matrix_file_error(path + " is truncated");
+		// Each count is bounded by division first, so a corrupt header cannot wrap the byte count past the check.
+		const size_t room = (size - hdr.offset) / hdr.elemSize, lines = hdr.column ? hdr.width : hdr.height;
+		if (hdr.height > room || hdr.width > room || hdr.stride > room || hdr.stride < (hdr.column ? hdr.height : hdr.width) || (lines && hdr.stride > room / lines))
+			throw matrix_file_error(path + " is truncated");
+	}
+
+	static std::ifstream openFile(const std::string& path, matrixFileHeader& hdr, size_t& size) {
+		std::ifstream in(path, std::ios::binary | std::ios::ate);
+		if (!in) throw matrix_file_error("Cannot open matrix file " + path);
+		size = (size_t)in.tellg();
+		in.seekg(0);
+		if (size < sizeof(matrixFileHeader) || !in.read((char*)&hdr, sizeof(hdr))) throw matrix_file_error(path + " is not a matrix file");
+		checkHeader(hdr, path);
+		return in;
+	}
+
+	static void readAt(std::ifstream& in, const size_t offset, void* p, const size_t n, const std::string& path) {
+		if (n == 0) return;
+		in.seekg((std::streamoff)offset);
+		if (!in.read((char*)p, (std::streamsize)n)) throw matrix_file_error(path + " is truncated");
+	}
+
+	// The index arrays come from disk, so they are checked against the stored shape before any kernel trusts them.
+	static void checkSparse(const matrixFileHeader& hdr, const std::vector<size_t>& outer, const std::vector<size_t>& inner, const std::string& path) {
+		const size_t nnz = inner.size();
+		if (hdr.kind == (uint8_t)storageKind::coo) {
+			if (outer.size() != nnz) throw matrix_file_error(path + " has a malformed sparse index");
+			for (size_t k = 0; k < nnz; k++)
+				if (outer[k] >= hdr.height || inner[k] >= hdr.width) throw matrix_file_error(path + " has a sparse index out of range");
+			return;
+		}
+		const bool csr = hdr.kind == (uint8_t)storageKind::csr;
+		const size_t lines = csr ? hdr.height : hdr.width, bound = csr ? hdr.width : hdr.height;
+		if (outer.empty() || outer.size() - 1 != lines || outer.front() != 0 || outer.back() != nnz) throw matrix_file_error(path + " has a malformed sparse index");
+		for (size_t l = 0; l < lines; l++)
+			if (outer[l] > outer[l + 1]) throw matrix_file_error(path + " has a malformed sparse index");
+		for (size_t k = 0; k < nnz; k++)
+			if (inner[k] >= bound) throw matrix_file_error(path + " has a sparse index out of range");
+	}
+
+	template<typename T, typename F>
+	static void readDense(const std::string& path, const size_t h, const size_t w, T* direct, const bool column, const size_t stride, F&& set) {
+		matrixFileHeader hdr;
+		size_t size;
+		std::ifstream in = openFile(path, hdr, size);
+		checkType<T>(hdr, path);
+		checkDense(hdr, size, path);
+		if (hdr.height != h || hdr.width != w) throw matrix_file_error(path + " holds a matrix of a different shape");
+		if (direct && (bool)hdr.column == column && hdr.stride == stride) {
+			readAt(in, hdr.offset, direct, denseBytes(hdr), path);
+			return;
+		}
+		std::vector<T> buf(denseBytes(hdr) / sizeof(T));
+		readAt(in, hdr.offset, buf.data(), denseBytes(hdr), path);
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				set(i, j, buf[hdr.column ? j * hdr.stride + i : i * hdr.stride + j]);
+	}
+
+	MATHPLUSPLUS_API [[nodiscard]] const matrixFileHeader readHeader(const std::string& path) {
+		matrixFileHeader hdr;
+		size_t size;
+		openFile(path, hdr, size);
+		return hdr;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void save(const std::string& path, const dmatrix<T>& x) {
+		const matrixFileHeader hdr = makeHeader<T>(storageKind::dense, x.height(), x.width(), false, x.width(), 0, fileAlign);
+		const std::vector<unsigned char> pad(hdr.offset - sizeof(hdr));
+		writeSegments(path, { { &hdr, sizeof(hdr) }, { pad.data(), pad.size() }, { x.data(), denseBytes(hdr) } });
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API void save(const std::string& path, const matrix<T, _H, _W, _L>& x) {
+		using M = matrix<T, _H, _W, _L>;
+		const matrixFileHeader hdr = makeHeader<T>(storageKind::dense, _H, _W, _L::column, M::stride, 0, std::max(fileAlign, _L::align));
+		const std::vector<unsigned char> pad(hdr.offset - sizeof(hdr));
+		writeSegments(path, { { &hdr, sizeof(hdr) }, { pad.data(), pad.size() }, { x.data(), denseBytes(hdr) } });
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void save(const std::string& path, const sparse_matrix<T>& x) {
+		const storageKind kind = x.format() == sparseFormat::coo ? storageKind::coo : x.format() == sparseFormat::csr ? storageKind::csr : storageKind::csc;
+		const matrixFileHeader hdr = makeHeader<T>(kind, x.height(), x.width(), false, x.outer().size(), x.nnz(), fileAlign);
+		std::vector<uint64_t> outer, inner;
+		const void* po = x.outer().data(), * pi = x.inner().data();
+		if constexpr (sizeof(size_t) != sizeof(uint64_t)) {
+			outer.assign(x.outer().begin(), x.outer().end());
+			inner.assign(x.inner().begin(), x.inner().end());
+			po = outer.data();
+			pi = inner.data();
+		}
+		const size_t no = x.outer().size() * sizeof(uint64_t), ni = x.nnz() * sizeof(uint64_t);
+		const size_t oi = alignUp(hdr.offset + no, fileAlign), ov = alignUp(oi + ni, fileAlign);
+		const std::vector<unsigned char> pad(fileAlign);
+		writeSegments(path, { { &hdr, sizeof(hdr) }, { pad.data(), hdr.offset - sizeof(hdr) }, { po, no }, { pad.data(), oi - hdr.offset - no },
+			{ pi, ni }, { pad.data(), ov - oi - ni }, { x.values().data(), x.nnz() * sizeof(T) } });
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void load(const std::string& path, dmatrix<T>& x) {
+		matrixFileHeader hdr;
+		size_t size;
+		openFile(path, hdr, size);
+		checkType<T>(hdr, path);
+		checkDense(hdr, size, path);
+		dmatrix<T> res(hdr.height, hdr.width);
+		readDense<T>(path, hdr.height, hdr.width, res.data(), false, hdr.width, [&](const size_t i, const size_t j, const T& v) { res(i, j) = v; });
+		x = std::move(res);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API void load(const std::string& path, matrix<T, _H, _W, _L>& x) {
+		using M = matrix<T, _H, _W, _L>;
+		readDense<T>(path, _H, _W, x.data(), _L::column, M::stride, [&](const size_t i, const size_t j, const T& v) { x(i, j) = v; });
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void load(const std::string& path, sparse_matrix<T>& x) {
+		matrixFileHeader hdr;
+		size_t size;
+		std::ifstream in = openFile(path, hdr, size);
+		checkType<T>(hdr, path);
+		if (hdr.kind == (uint8_t)storageKind::dense || hdr.kind > (uint8_t)storageKind::csc) throw matrix_file_error(path + " does not hold a sparse matrix");
+		// Counts are bounded by the file size first, so a corrupt header cannot overflow the offsets or force a huge allocation.
+		if (hdr.offset > size || hdr.stride > size / sizeof(uint64_t) || hdr.nnz > size / sizeof(uint64_t)) throw matrix_file_error(path + " is truncated");
+		const size_t no = hdr.stride * sizeof(uint64_t), ni = hdr.nnz * sizeof(uint64_t);
+		const size_t oi = alignUp(hdr.offset + no, hdr.align), ov = alignUp(oi + ni, hdr.align);
+		if (ov + hdr.nnz * sizeof(T) > size) throw matrix_file_error(path + " is truncated");
+		std::vector<size_t> outer(hdr.stride), inner(hdr.nnz);
+		std::vector<T> values(hdr.nnz);
+		if constexpr (sizeof(size_t) == sizeof(uint64_t)) {
+			readAt(in, hdr.offset, outer.data(), no, path);
+			readAt(in, oi, inner.data(), ni, path);
+		}
+		else {
+			std::vector<uint64_t> o(hdr.stride), n(hdr.nnz);
+			readAt(in, hdr.offset, o.data(), no, path);
+			readAt(in, oi, n.data(), ni, path);
+			outer.assign(o.begin(), o.end());
+			inner.assign(n.begin(), n.end());
+		}
+		checkSparse(hdr, outer, inner, path);
+		readAt(in, ov, values.data(), hdr.nnz * sizeof(T), path);
+		const sparseFormat f = hdr.kind == (uint8_t)storageKind::coo ? sparseFormat::coo : hdr.kind == (uint8_t)storageKind::csr ? sparseFormat::csr : sparseFormat::csc;
+		x = sparse_matrix<T>(hdr.height, hdr.width, f, std::move(outer), std::move(inner), std::move(values));
+	}
+
+	MATHPLUSPLUS_API mappedFile::mappedFile() : p(nullptr), n(0) {
+#ifdef _WIN32
+		file = mapping = nullptr;
+#endif
+	}
+	MATHPLUSPLUS_API mappedFile::mappedFile(const std::string& path) : mappedFile() {
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			file = nullptr;
+			throw matrix_file_error("Cannot open matrix file " + path);
+		}
+		LARGE_INTEGER size;
+		GetFileSizeEx(file, &size);
+		n = (size_t)size.QuadPart;
+		if (n == 0) return;
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping) p = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		// The delegated constructor has finished, so throwing here still releases the handles.
+		if (!p) throw matrix_file_error("Cannot map matrix file " + path);
+#else
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) throw matrix_file_error("Cannot open matrix file " + path);
+		struct stat st;
+		if (::fstat(fd, &st) != 0) {
+			::close(fd);
+			throw matrix_file_error("Cannot open matrix file " + path);
+		}
+		n = (size_t)st.st_size;
+		if (n) {
+			void* m = ::mmap(nullptr, n, PROT_READ, MAP_SHARED, fd, 0);
+			if (m == MAP_FAILED) {
+				::close(fd);
+				throw matrix_file_error("Cannot map matrix file " + path);
+			}
+			p = (const unsigned char*)m;
+		}
+		::close(fd);
+#endif
+	}
+	MATHPLUSPLUS_API mappedFile::mappedFile(mappedFile&& x) noexcept : p(x.p), n(x.n) {
+#ifdef _WIN32
+		file = x.file;
+		mapping = x.mapping;
+		x.file = x.mapping = nullptr;
+#endif
+		x.p = nullptr;
+		x.n = 0;
+	}
+	MATHPLUSPLUS_API mappedFile::~mappedFile() {
+#ifdef _WIN32
+		if (p) UnmapViewOfFile(p);
+		if (mapping) CloseHandle(mapping);
+		if (file) CloseHandle(file);
+#else
+		if (p) ::munmap((void*)p, n);
+#endif
+	}
+
+	MATHPLUSPLUS_API mappedFile& mappedFile::operator=(mappedFile&& x) noexcept {
+		mappedFile tmp(std::move(x));
+		std::swap(p, tmp.p);
+		std::swap(n, tmp.n);
+#ifdef _WIN32
+		std::swap(file, tmp.file);
+		std::swap(mapping, tmp.mapping);
+#endif
+		return *this;
+	}
+
+	MATHPLUSPLUS_API [[nodiscard]] inline const unsigned char* mappedFile::data() const {
+		return p;
+	}
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t mappedFile::size() const {
+		return n;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API mappedMatrix<T>::mappedMatrix(const std::string& path) : f(path), p(nullptr) {
+		if (f.size() < sizeof(hdr)) throw matrix_file_error(path + " is not a matrix file");
+		std::memcpy(&hdr, f.data(), sizeof(hdr));
+		checkHeader(hdr, path);
+		checkType<T>(hdr, path);
+		checkDense(hdr, f.size(), path);
+		if (hdr.offset % alignof(T) != 0) throw matrix_file_error(path + " stores misaligned elements");
+		p = (const T*)(f.data() + hdr.offset);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t mappedMatrix<T>::height() const {
+		return hdr.height;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t mappedMatrix<T>::width() const {
+		return hdr.width;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const matrixFileHeader& mappedMatrix<T>::header() const {
+		return hdr;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const T* mappedMatrix<T>::data() const {
+		return p;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> mappedMatrix<T>::view() const {
+		return hdr.column ? matrixView<const T>(p, hdr.height, hdr.width, 1, hdr.stride) : matrixView<const T>(p, hdr.height, hdr.width, hdr.stride, 1);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> mappedMatrix<T>::eval() const {
+		return view().eval();
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const T& mappedMatrix<T>::operator()(const size_t& i, const size_t& j) const {
+		return hdr.column ? p[j * hdr.stride + i] : p[i * hdr.stride + j];
+	}
+}
@@ -0,0 +1,416 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "matfun.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace math {
+
+	MATHPLUSPLUS_API not_positive_definite::not_positive_definite() : std::runtime_error("Matrix function requires a symmetric positive definite matrix") {}
+
+	static constexpr size_t workspaceSlots = 8;
+
+	template<typename T>
+	MATHPLUSPLUS_API matrixWorkspace<T>::matrixWorkspace(const size_t n) : n(0) {
+		reserve(n);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void matrixWorkspace<T>::reserve(const size_t n) {
+		if (this->n == n) return;
+		this->n = n;
+		if (buf.size() < workspaceSlots * n * n) buf.resize(workspaceSlots * n * n);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t matrixWorkspace<T>::size() const {
+		return n;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline T* matrixWorkspace<T>::slot(const size_t k) {
+		return buf.data() + k * n * n;
+	}
+
+	template<typename T>
+	static void load(const T* a, const size_t lda, T* x, const size_t n) {
+		for (size_t i = 0; i < n; i++)
+			std::copy(a + i * lda, a + i * lda + n, x + i * n);
+	}
+	template<typename T>
+	static void store(const T* x, T* a, const size_t lda, const size_t n) {
+		for (size_t i = 0; i < n; i++)
+			std::copy(x + i * n, x + (i + 1) * n, a + i * lda);
+	}
+	template<typename T>
+	static void identity(T* x, const size_t n) {
+		std::fill_n(x, n * n, T(0));
+		for (size_t i = 0; i < n; i++)
+			x[i * n + i] = T(1);
+	}
+	template<typename T>
+	static void mulInto(const T* a, const T* b, T* c, const size_t n) {
+		std::fill_n(c, n * n, T(0));
+		for (size_t i = 0; i < n; i++)
+			for (size_t k = 0; k < n; k++) {
+				const T aik = a[i * n + k];
+				for (size_t j = 0; j < n; j++)
+					c[i * n + j] += aik * b[k * n + j];
+			}
+	}
+	template<typename T>
+	static void axpy(T* y, const T c, const T* x, const size_t n) {
+		for (size_t i = 0; i < n * n; i++)
+			y[i] += c * x[i];
+	}
+	template<typename T>
+	static const T norm1(const T* x, const size_t n) {
+		T res = 0;
+		for (size_t j = 0; j < n; j++) {
+			T s = 0;
+			for (size_t i = 0; i < n; i++)
+				s += std::abs(x[i * n + j]);
+			res = std::max(res, s);
+		}
+		return res;
+	}
+	template<typename T>
+	static void solveInto(T* a, T* b, const size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			size_t piv = i;
+			for (size_t j = i + 1; j < n; j++)
+				if (std::abs(a[j * n + i]) > std::abs(a[piv * n + i])) piv = j;
+			if (a[piv * n + i] == 0) throw singular_matrix();
+			if (piv != i) {
+				std::swap_ranges(a + i * n, a + (i + 1) * n, a + piv * n);
+				std::swap_ranges(b + i * n, b + (i + 1) * n, b + piv * n);
+			}
+			for (size_t j = i + 1; j < n; j++) {
+				const T f = a[j * n + i] / a[i * n + i];
+				if (f == 0) continue;
+				for (size_t k = i; k < n; k++)
+					a[j * n + k] -= f * a[i * n + k];
+				for (size_t k = 0; k < n; k++)
+					b[j * n + k] -= f * b[i * n + k];
+			}
+		}
+		for (size_t i = n; i-- > 0;) {
+			for (size_t j = i + 1; j < n; j++) {
+				const T f = a[i * n + j];
+				for (size_t k = 0; k < n; k++)
+					b[i * n + k] -= f * b[j * n + k];
+			}
+			for (size_t k = 0; k < n; k++)
+				b[i * n + k] /= a[i * n + i];
+		}
+	}
+
+	template<typename T>
+	static void powKernel(const T* a, const size_t lda, uint64_t e, T* out, const size_t ldo, const size_t n, matrixWorkspace<T>& ws) {
+		ws.reserve(n);
+		T* r = ws.slot(0), * b = ws.slot(1), * t = ws.slot(2);
+		load(a, lda, b, n);
+		identity(r, n);
+		while (e) {
+			if (e & 1) {
+				mulInto(r, b, t, n);
+				std::swap(r, t);
+			}
+			e >>= 1;
+			if (e) {
+				mulInto(b, b, t, n);
+				std::swap(b, t);
+			}
+		}
+		store(r, out, ldo, n);
+	}
+
+	template<typename T>
+	static void expmKernel(const T* a, const size_t lda, T* out, const size_t ldo, const size_t n, matrixWorkspace<T>& ws) {
+		static_assert(std::is_floating_point_v<T>, "math::expm requires a floating-point element type.");
+		static constexpr double theta[] = { 1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068e0, 5.371920351148152e0 };
+		static constexpr double pade[4][10] = {
+			{ 120., 60., 12., 1. },
+			{ 30240., 15120., 3360., 420., 30., 1. },
+			{ 17297280., 8648640., 1995840., 277200., 25200., 1512., 56., 1. },
+			{ 17643225600., 8821612800., 2075673600., 302702400., 30270240., 2162160., 110880., 3960., 90., 1. }
+		};
+		static constexpr double b[] = { 64764752532480000., 32382376266240000., 7771770303897600., 1187353796428800., 129060195264000.,
+			10559470521600., 670442572800., 33522128640., 1323241920., 40840800., 960960., 16380., 182., 1. };
+		ws.reserve(n);
+		T* x = ws.slot(0), * a2 = ws.slot(1), * a4 = ws.slot(2), * a6 = ws.slot(3), * a8 = ws.slot(4), * u = ws.slot(5), * v = ws.slot(6), * t = ws.slot(7);
+		load(a, lda, x, n);
+		const T nrm = norm1(x, n);
+		int s = 0;
+		size_t m = 0;
+		while (m < 4 && nrm > theta[m])
+			m++;
+		if (m == 4 && nrm > theta[4]) {
+			s = (int)std::ceil(std::log2(nrm / theta[4]));
+			for (size_t i = 0; i < n * n; i++)
+				x[i] = std::ldexp(x[i], -s);
+		}
+		mulInto(x, x, a2, n);
+		mulInto(a2, a2, a4, n);
+		mulInto(a2, a4, a6, n);
+		if (m < 4) {
+			const double* c = pade[m];
+			const size_t deg = 2 * m + 3;
+			if (deg >= 9) mulInto(a4, a4, a8, n);
+			const T* p[] = { nullptr, a2, a4, a6, a8 };
+			identity(t, n);
+			for (size_t i = 0; i < n * n; i++)
+				t[i] *= c[1];
+			identity(v, n);
+			for (size_t i = 0; i < n * n; i++)
+				v[i] *= c[0];
+			for (size_t k = 2; k <= deg; k += 2) {
+				axpy(v, T(c[k]), p[k / 2], n);
+				axpy(t, T(c[k + 1]), p[k / 2], n);
+			}
+			mulInto(x, t, u, n);
+		}
+		else {
+			std::fill_n(t, n * n, T(0));
+			axpy(t, T(b[13]), a6, n);
+			axpy(t, T(b[11]), a4, n);
+			axpy(t, T(b[9]), a2, n);
+			mulInto(a6, t, a8, n);
+			axpy(a8, T(b[7]), a6, n);
+			axpy(a8, T(b[5]), a4, n);
+			axpy(a8, T(b[3]), a2, n);
+			for (size_t i = 0; i < n; i++)
+				a8[i * n + i] += T(b[1]);
+			mulInto(x, a8, u, n);
+			std::fill_n(t, n * n, T(0));
+			axpy(t, T(b[12]), a6, n);
+			axpy(t, T(b[10]), a4, n);
+			axpy(t, T(b[8]), a2, n);
+			mulInto(a6, t, v, n);
+			axpy(v, T(b[6]), a6, n);
+			axpy(v, T(b[4]), a4, n);
+			axpy(v, T(b[2]), a2, n);
+			for (size_t i = 0; i < n; i++)
+				v[i * n + i] += T(b[0]);
+		}
+		for (size_t i = 0; i < n * n; i++) {
+			const T p = v[i] + u[i];
+			t[i] = v[i] - u[i];
+			v[i] = p;
+		}
+		solveInto(t, v, n);
+		for (; s > 0; s--) {
+			mulInto(v, v, t, n);
+			std::swap(v, t);
+		}
+		store(v, out, ldo, n);
+	}
+
+	template<typename T, typename F>
+	static void symmetricKernel(const T* a, const size_t lda, T* out, const size_t ldo, const size_t n, matrixWorkspace<T>& ws, F&& f) {
+		static_assert(std::is_floating_point_v<T>, "math::sqrtm and math::logm require a floating-point element type.");
+		ws.reserve(n);
+		T* x = ws.slot(0), * v = ws.slot(1), * d = ws.slot(2), * w = ws.slot(3);
+		load(a, lda, x, n);
+		identity(v, n);
+		T total = 0;
+		for (size_t i = 0; i < n * n; i++)
+			total += x[i] * x[i];
+		const T eps = std::numeric_limits<T>::epsilon();
+		// Jacobi only diagonalizes symmetric input, so anything further from symmetric than rounding is rejected.
+		const T tol = T(n) * eps * std::sqrt(total);
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = i + 1; j < n; j++)
+				if (!(std::abs(x[i * n + j] - x[j * n + i]) <= tol)) throw not_positive_definite();
+		for (size_t sweep = 0; sweep < 64; sweep++) {
+			T off = 0;
+			for (size_t p = 0; p < n; p++)
+				for (size_t q = p + 1; q < n; q++)
+					off += x[p * n + q] * x[p * n + q];
+			if (off <= eps * eps * total) break;
+			for (size_t p = 0; p < n; p++)
+				for (size_t q = p + 1; q < n; q++) {
+					const T apq = x[p * n + q];
+					if (apq == 0) continue;
+					const T theta = (x[q * n + q] - x[p * n + p]) / (2 * apq);
+					const T tn = (theta < 0 ? -1 : 1) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+					const T c = 1 / std::sqrt(tn * tn + 1), s = tn * c;
+					for (size_t k = 0; k < n; k++) {
+						const T kp = x[k * n + p], kq = x[k * n + q];
+						x[k * n + p] = c * kp - s * kq;
+						x[k * n + q] = s * kp + c * kq;
+					}
+					for (size_t k = 0; k < n; k++) {
+						const T pk = x[p * n + k], qk = x[q * n + k];
+						x[p * n + k] = c * pk - s * qk;
+						x[q * n + k] = s * pk + c * qk;
+					}
+					for (size_t k = 0; k < n; k++) {
+						const T kp = v[k * n + p], kq = v[k * n + q];
+						v[k * n + p] = c * kp - s * kq;
+						v[k * n + q] = s * kp + c * kq;
+					}
+				}
+		}
+		for (size_t k = 0; k < n; k++) {
+			if (!(x[k * n + k] > 0)) throw not_positive_definite();
+			d[k] = f(x[k * n + k]);
+		}
+		for (size_t i = 0; i < n; i++)
+			for (size_t k = 0; k < n; k++)
+				w[i * n + k] = v[i * n + k] * d[k];
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = 0; j < n; j++) {
+				T s = 0;
+				for (size_t k = 0; k < n; k++)
+					s += w[i * n + k] * v[j * n + k];
+				x[i * n + j] = s;
+			}
+		store(x, out, ldo, n);
+	}
+
+	template<typename T>
+	static const T sqrtOf(const T x) {
+		return std::sqrt(x);
+	}
+	template<typename T>
+	static const T logOf(const T x) {
+		return std::log(x);
+	}
+
+	template<typename T>
+	static void fit(const dmatrix<T>& a, dmatrix<T>& res) {
+		if (a.height() != a.width()) throw non_square_matrix();
+		if (res.height() != a.height() || res.width() != a.width()) res = dmatrix<T>(a.height(), a.width());
+	}
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> pow(const sqMatrix<T, _N, _L>& a, const uint64_t e) {
+		sqMatrix<T, _N, _L> res = sqMatrix<T, _N, _L>::idMatrix(), b = a;
+		for (uint64_t k = e; k; k >>= 1) {
+			if (k & 1) res *= b;
+			if (k > 1) b *= b;
+		}
+		return res;
+	}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> pow(const sqMatrix<T, _N, _L>& a, const uint64_t e, matrixWorkspace<T>& ws) {
+		sqMatrix<T, _N, _L> res;
+		powKernel(a.data(), a.stride, e, res.data(), res.stride, _N, ws);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> pow(const dmatrix<T>& a, const uint64_t e) {
+		matrixWorkspace<T> ws(a.height());
+		dmatrix<T> res;
+		pow(a, e, res, ws);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void pow(const dmatrix<T>& a, const uint64_t e, dmatrix<T>& res, matrixWorkspace<T>& ws) {
+		fit(a, res);
+		powKernel(a.data(), a.width(), e, res.data(), res.width(), a.height(), ws);
+	}
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> expm(const sqMatrix<T, _N, _L>& a) {
+		matrixWorkspace<T> ws(_N);
+		return expm(a, ws);
+	}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> expm(const sqMatrix<T, _N, _L>& a, matrixWorkspace<T>& ws) {
+		sqMatrix<T, _N, _L> res;
+		expmKernel(a.data(), a.stride, res.data(), res.stride, _N, ws);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> expm(const dmatrix<T>& a) {
+		matrixWorkspace<T> ws(a.height());
+		dmatrix<T> res;
+		expm(a, res, ws);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void expm(const dmatrix<T>& a, dmatrix<T>& res, matrixWorkspace<T>& ws) {
+		fit(a, res);
+		expmKernel(a.data(), a.width(), res.data(), res.width(), a.height(), ws);
+	}
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> sqrtm(const sqMatrix<T, _N, _L>& a) {
+		matrixWorkspace<T> ws(_N);
+		return sqrtm(a, ws);
+	}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> sqrtm(const sqMatrix<T, _N, _L>& a, matrixWorkspace<T>& ws) {
+		sqMatrix<T, _N, _L> res;
+		symmetricKernel(a.data(), a.stride, res.data(), res.stride, _N, ws, sqrtOf<T>);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> sqrtm(const dmatrix<T>& a) {
+		matrixWorkspace<T> ws(a.height());
+		dmatrix<T> res;
+		sqrtm(a, res, ws);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void sqrtm(const dmatrix<T>& a, dmatrix<T>& res, matrixWorkspace<T>& ws) {
+		fit(a, res);
+		symmetricKernel(a.data(), a.width(), res.data(), res.width(), a.height(), ws, sqrtOf<T>);
+	}
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> logm(const sqMatrix<T, _N, _L>& a) {
+		matrixWorkspace<T> ws(_N);
+		return logm(a, ws);
+	}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const sqMatrix<T, _N, _L> logm(const sqMatrix<T, _N, _L>& a, matrixWorkspace<T>& ws) {
+		sqMatrix<T, _N, _L> res;
+		symmetricKernel(a.data(), a.stride, res.data(), res.stride, _N, ws, logOf<T>);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> logm(const dmatrix<T>& a) {
+		matrixWorkspace<T> ws(a.height());
+		dmatrix<T> res;
+		logm(a, res, ws);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void logm(const dmatrix<T>& a, dmatrix<T>& res, matrixWorkspace<T>& ws) {
+		fit(a, res);
+		symmetricKernel(a.data(), a.width(), res.data(), res.width(), a.height(), ws, logOf<T>);
+	}
+}
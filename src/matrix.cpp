@@ -31,300 +31,849 @@ POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "matrix.h"
+#include "exact.h"
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <immintrin.h>
+#define _MX_SSE_
+#endif // SSE
+#ifdef __AVX__
+#define _MX_AVX_
+#endif // __AVX__
 
 namespace math {
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API constexpr matrix<T, _H, _W>::matrix() {
+	MATHPLUSPLUS_API singular_matrix::singular_matrix() : std::runtime_error("Matrix is singular and cannot be inverted") {}
+
+
+	template<typename S>
+	MATHPLUSPLUS_API constexpr strideRef<S>::strideRef(S* s, const size_t i) : s(s), i(i) {}
+
+	template<typename S>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline auto& strideRef<S>::operator[](const size_t& j) const {
+		return (*s)[j][i];
+	}
+
+	template<size_t _N, typename F>
+	static constexpr inline void unroll(F&& f) {
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			(f(std::integral_constant<size_t, I>()), ...);
+		}(std::make_index_sequence<_N>());
+	}
+
+	template<typename A, typename B>
+	static constexpr bool sameStorage = A::policy::column == B::policy::column && A::stride == B::stride;
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& matrix<T, _H, _W, _L>::at(const size_t& i, const size_t& j) {
+		if constexpr (_L::column) return buf[j][i];
+		else return buf[i][j];
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& matrix<T, _H, _W, _L>::elem(const size_t& k) const {
+		if constexpr (stride == length) return buf[0].data()[k];
+		else return buf[k / length][k % length];
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& matrix<T, _H, _W, _L>::at(const size_t& i, const size_t& j) const {
+		if constexpr (_L::column) return buf[j][i];
+		else return buf[i][j];
+	}
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API constexpr matrix<T, _H, _W, _L>::matrix() {
 		for (auto& r : buf)
 			r.fill(0);
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
 	template<typename U>
-	MATHPLUSPLUS_API constexpr matrix<T, _H, _W>::matrix(const std::array<std::array<U, _W>, _H>& buff) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] = buff[i][j];
+	MATHPLUSPLUS_API constexpr matrix<T, _H, _W, _L>::matrix(const std::array<std::array<U, _W>, _H>& buff) {
+		for (size_t i = 0; i < _H; i++)
+			for (size_t j = 0; j < _W; j++)
+				at(i, j) = buff[i][j];
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
 	template<typename U>
-	MATHPLUSPLUS_API constexpr matrix<T, _H, _W>::matrix(const std::initializer_list<std::initializer_list<U>>& buff) {
-		_MX_SIZE_T_ i = 0;
+	MATHPLUSPLUS_API constexpr matrix<T, _H, _W, _L>::matrix(const std::initializer_list<std::initializer_list<U>>& buff) {
+		size_t i = 0;
 		for (auto& row : buff) {
-			_MX_SIZE_T_ j = 0;
+			size_t j = 0;
 			for (auto& elem : row) {
-				buf[i][j] = elem;
+				at(i, j) = elem;
 				j++;
 			}
 			i++;
 		}
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr matrix<T, _H, _W>::matrix(const matrix<U, _H, _W>& x) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] = x[i][j];
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API constexpr matrix<T, _H, _W, _L>::matrix(const matrix<U, _H, _W, _M>& x) {
+		*this = x;
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API matrix<T, _H, _W>& matrix<T, _H, _W>::mask(matrix<U, _H, _W> x) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] *= x[i][j];
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API matrix<T, _H, _W, _L>& matrix<T, _H, _W, _L>::mask(const matrix<U, _H, _W, _M>& x) {
+		if constexpr (sameStorage<matrix<T, _H, _W, _L>, matrix<U, _H, _W, _M>>) {
+			for (size_t l = 0; l < lines; l++)
+				for (size_t k = 0; k < stride; k++)
+					buf[l][k] *= x.buf[l][k];
+		}
+		else {
+			for (size_t i = 0; i < _H; i++)
+				for (size_t j = 0; j < _W; j++)
+					at(i, j) *= x.at(i, j);
+		}
 		return *this;
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] const matrix<T, _W, _H> matrix<T, _H, _W>::trans() const {
-		matrix<T, _W, _H> res;
-		for (_MX_SIZE_T_ i = 0; i < _W; i++)
-			for (_MX_SIZE_T_ j = 0; j < _H; j++)
-				res[i][j] = buf[j][i];
+	template<typename T>
+	static inline void transTile(const T* a, const size_t lda, T* b, const size_t ldb) {
+#ifdef _MX_AVX_
+		if constexpr (std::is_same_v<T, float>) {
+			__m256 r0 = _mm256_loadu_ps(a), r1 = _mm256_loadu_ps(a + lda), r2 = _mm256_loadu_ps(a + 2 * lda), r3 = _mm256_loadu_ps(a + 3 * lda);
+			__m256 r4 = _mm256_loadu_ps(a + 4 * lda), r5 = _mm256_loadu_ps(a + 5 * lda), r6 = _mm256_loadu_ps(a + 6 * lda), r7 = _mm256_loadu_ps(a + 7 * lda);
+			__m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1), t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3);
+			__m256 t4 = _mm256_unpacklo_ps(r4, r5), t5 = _mm256_unpackhi_ps(r4, r5), t6 = _mm256_unpacklo_ps(r6, r7), t7 = _mm256_unpackhi_ps(r6, r7);
+			r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+			r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+			r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+			r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+			r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+			_mm256_storeu_ps(b, _mm256_permute2f128_ps(r0, r4, 0x20));
+			_mm256_storeu_ps(b + ldb, _mm256_permute2f128_ps(r1, r5, 0x20));
+			_mm256_storeu_ps(b + 2 * ldb, _mm256_permute2f128_ps(r2, r6, 0x20));
+			_mm256_storeu_ps(b + 3 * ldb, _mm256_permute2f128_ps(r3, r7, 0x20));
+			_mm256_storeu_ps(b + 4 * ldb, _mm256_permute2f128_ps(r0, r4, 0x31));
+			_mm256_storeu_ps(b + 5 * ldb, _mm256_permute2f128_ps(r1, r5, 0x31));
+			_mm256_storeu_ps(b + 6 * ldb, _mm256_permute2f128_ps(r2, r6, 0x31));
+			_mm256_storeu_ps(b + 7 * ldb, _mm256_permute2f128_ps(r3, r7, 0x31));
+			return;
+		}
+		if constexpr (std::is_same_v<T, double>) {
+			for (size_t i = 0; i < 8; i += 4)
+				for (size_t j = 0; j < 8; j += 4) {
+					const double* s = a + i * lda + j;
+					double* d = b + j * ldb + i;
+					__m256d r0 = _mm256_loadu_pd(s), r1 = _mm256_loadu_pd(s + lda), r2 = _mm256_loadu_pd(s + 2 * lda), r3 = _mm256_loadu_pd(s + 3 * lda);
+					__m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1), t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+					_mm256_storeu_pd(d, _mm256_permute2f128_pd(t0, t2, 0x20));
+					_mm256_storeu_pd(d + ldb, _mm256_permute2f128_pd(t1, t3, 0x20));
+					_mm256_storeu_pd(d + 2 * ldb, _mm256_permute2f128_pd(t0, t2, 0x31));
+					_mm256_storeu_pd(d + 3 * ldb, _mm256_permute2f128_pd(t1, t3, 0x31));
+				}
+			return;
+		}
+#endif // _MX_AVX_
+#ifdef _MX_SSE_
+		if constexpr (std::is_same_v<T, float>) {
+			for (size_t i = 0; i < 8; i += 4)
+				for (size_t j = 0; j < 8; j += 4) {
+					const float* s = a + i * lda + j;
+					float* d = b + j * ldb + i;
+					__m128 r0 = _mm_loadu_ps(s), r1 = _mm_loadu_ps(s + lda), r2 = _mm_loadu_ps(s + 2 * lda), r3 = _mm_loadu_ps(s + 3 * lda);
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+					_mm_storeu_ps(d, r0);
+					_mm_storeu_ps(d + ldb, r1);
+					_mm_storeu_ps(d + 2 * ldb, r2);
+					_mm_storeu_ps(d + 3 * ldb, r3);
+				}
+			return;
+		}
+#endif // _MX_SSE_
+		for (size_t i = 0; i < 8; i++)
+			for (size_t j = 0; j < 8; j++)
+				b[j * ldb + i] = a[i * lda + j];
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void transKernel(const T* a, const size_t lda, T* b, const size_t ldb, const size_t r, const size_t c) {
+		if (r <= 64 && c <= 64) {
+			size_t i = 0;
+			for (; i + 8 <= r; i += 8) {
+				size_t j = 0;
+				for (; j + 8 <= c; j += 8)
+					transTile(a + i * lda + j, lda, b + j * ldb + i, ldb);
+				for (; j < c; j++)
+					for (size_t k = i; k < i + 8; k++)
+						b[j * ldb + k] = a[k * lda + j];
+			}
+			for (; i < r; i++)
+				for (size_t j = 0; j < c; j++)
+					b[j * ldb + i] = a[i * lda + j];
+			return;
+		}
+		if (r >= c) {
+			const size_t h = (r / 2 + 7) & ~(size_t)7;
+			transKernel(a, lda, b, ldb, h, c);
+			transKernel(a + h * lda, lda, b + h, ldb, r - h, c);
+		}
+		else {
+			const size_t h = (c / 2 + 7) & ~(size_t)7;
+			transKernel(a, lda, b, ldb, r, h);
+			transKernel(a + h, lda, b + h * ldb, ldb, r, c - h);
+		}
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void transInPlace(T* a, const size_t lda, const size_t n, const execution pol) {
+		const size_t nb = n & ~(size_t)7;
+		parallelFor(pol, 0, nb / 8, 1, [&](const size_t lo, const size_t hi) {
+			T t0[64], t1[64];
+			for (size_t bi = lo; bi < hi; bi++) {
+				const size_t i0 = bi * 8;
+				for (size_t i = i0; i < i0 + 8; i++)
+					for (size_t j = i + 1; j < i0 + 8; j++)
+						std::swap(a[i * lda + j], a[j * lda + i]);
+				for (size_t j0 = i0 + 8; j0 < nb; j0 += 8) {
+					transTile(a + i0 * lda + j0, lda, t0, 8);
+					transTile(a + j0 * lda + i0, lda, t1, 8);
+					for (size_t k = 0; k < 8; k++)
+						for (size_t l = 0; l < 8; l++) {
+							a[(j0 + k) * lda + i0 + l] = t0[k * 8 + l];
+							a[(i0 + k) * lda + j0 + l] = t1[k * 8 + l];
+						}
+				}
+			}
+		});
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = std::max(i + 1, nb); j < n; j++)
+				std::swap(a[i * lda + j], a[j * lda + i]);
+	}
+
+
+	template<typename A, typename B, typename C>
+	static constexpr inline void mulLines(const A& a, const B& b, C& c, const size_t lo, const size_t hi) {
+		constexpr size_t n = A::width();
+		if constexpr (!A::policy::column && !B::policy::column && !C::policy::column) {
+			constexpr size_t m = B::stride == C::stride ? C::stride : C::width();
+			for (size_t i = lo; i < hi; i++)
+				for (size_t k = 0; k < n; k++)
+					for (size_t j = 0; j < m; j++)
+						c.line(i)[j] += a.line(i)[k] * b.line(k)[j];
+		}
+		else if constexpr (A::policy::column && B::policy::column && C::policy::column) {
+			constexpr size_t m = A::stride == C::stride ? C::stride : C::height();
+			for (size_t j = lo; j < hi; j++)
+				for (size_t k = 0; k < n; k++)
+					for (size_t i = 0; i < m; i++)
+						c.line(j)[i] += a.line(k)[i] * b.line(j)[k];
+		}
+		else {
+			for (size_t l = lo; l < hi; l++)
+				for (size_t k = 0; k < n; k++)
+					for (size_t r = 0; r < C::length; r++) {
+						const size_t i = C::policy::column ? r : l, j = C::policy::column ? l : r;
+						c(i, j) += a(i, k) * b(k, j);
+					}
+		}
+	}
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const _MX_SIZE_T_ matrix<T, _H, _W, _L>::height() {
+		return _H;
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const _MX_SIZE_T_ matrix<T, _H, _W, _L>::width() {
+		return _W;
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const matrix<T, _W, _H, _L> matrix<T, _H, _W, _L>::trans() const {
+		matrix<T, _W, _H, _L> res;
+		if constexpr (_H <= 4 && _W <= 4)
+			unroll<_H>([&](auto i) { unroll<_W>([&](auto j) { res.at(j, i) = at(i, j); }); });
+		else if (std::is_constant_evaluated()) {
+			for (size_t i = 0; i < _H; i++)
+				for (size_t j = 0; j < _W; j++)
+					res.at(j, i) = at(i, j);
+		}
+		else transKernel(buf[0].data(), stride, res.line(0).data(), res.stride, lines, length);
 		return res;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] const auto matrix<T, _H, _W>::masked(matrix<U, _H, _W> x) const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const transView<matrix<T, _H, _W, _L>> matrix<T, _H, _W, _L>::t() const {
+		return transView<matrix<T, _H, _W, _L>>(*this);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrix<T, _H, _W, _L>::masked(const matrix<U, _H, _W, _M>& x) const {
 		using V = decltype(T()* U());
-		matrix<V, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				res[i][j] = buf[i][j] * x[i][j];
+		matrix<V, _H, _W, _L> res = *this;
+		return res.mask(x);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename F>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrix<T, _H, _W, _L>::map(F&& f, const execution pol) const {
+		constexpr bool indexed = std::is_invocable_v<F&, const T&, size_t, size_t>;
+		using U = std::decay_t<typename std::conditional_t<indexed, std::invoke_result<F&, const T&, size_t, size_t>, std::invoke_result<F&, const T&>>::type>;
+		matrix<U, _H, _W, _L> res;
+		parallelFor(pol, 0, lines, std::max<size_t>(1, 4096 / length), [&](const size_t lo, const size_t hi) {
+			for (size_t l = lo; l < hi; l++) {
+				const T* a = buf[l].data();
+				U* out = res.buf[l].data();
+				for (size_t p = 0; p < length; p++) {
+					if constexpr (!indexed) out[p] = f(a[p]);
+					else if constexpr (_L::column) out[p] = f(a[p], p, l);
+					else out[p] = f(a[p], l, p);
+				}
+			}
+		});
 		return res;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] const matrix<U, _H, _W> matrix<T, _H, _W>::map(U(*f)()) const {
-		matrix<U, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				res[i][j] = f(buf[i][j], i, j);
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M, typename F>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrix<T, _H, _W, _L>::zipMap(const matrix<U, _H, _W, _M>& x, F&& f, const execution pol) const {
+		using V = std::decay_t<std::invoke_result_t<F&, const T&, const U&>>;
+		matrix<V, _H, _W, _L> res;
+		parallelFor(pol, 0, lines, std::max<size_t>(1, 4096 / length), [&](const size_t lo, const size_t hi) {
+			for (size_t l = lo; l < hi; l++) {
+				const T* a = buf[l].data();
+				V* out = res.buf[l].data();
+				if constexpr (sameStorage<matrix<T, _H, _W, _L>, matrix<U, _H, _W, _M>>) {
+					const U* b = x.buf[l].data();
+					for (size_t p = 0; p < length; p++)
+						out[p] = f(a[p], b[p]);
+				}
+				else {
+					for (size_t p = 0; p < length; p++)
+						out[p] = _L::column ? f(a[p], x.at(p, l)) : f(a[p], x.at(l, p));
+				}
+			}
+		});
+		return res;
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const T matrix<T, _H, _W, _L>::sum(const execution pol) const {
+		using A = typename accumType<T>::type;
+		return T(parallelReduce(pol, 0, _H * _W, 4096, A{}, [&](const size_t lo, const size_t hi) {
+			return pairwiseSum<A>(lo, hi, [&](const size_t k) { return A(elem(k)); });
+		}, std::plus<A>()));
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const T matrix<T, _H, _W, _L>::min(const execution pol) const {
+		auto lesser = [](const T& a, const T& b) { return b < a ? b : a; };
+		return parallelReduce(pol, 0, _H * _W, 4096, elem(0), [&](const size_t lo, const size_t hi) {
+			T res = elem(lo);
+			for (size_t k = lo + 1; k < hi; k++)
+				res = lesser(res, elem(k));
+			return res;
+		}, lesser);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const T matrix<T, _H, _W, _L>::max(const execution pol) const {
+		auto greater = [](const T& a, const T& b) { return a < b ? b : a; };
+		return parallelReduce(pol, 0, _H * _W, 4096, elem(0), [&](const size_t lo, const size_t hi) {
+			T res = elem(lo);
+			for (size_t k = lo + 1; k < hi; k++)
+				res = greater(res, elem(k));
+			return res;
+		}, greater);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrix<T, _H, _W, _L>::norm(const execution pol) const {
+		using std::abs;
+		using std::sqrt;
+		using V = typename accumType<std::decay_t<decltype(abs(std::declval<const T&>()))>>::type;
+		return sqrt(parallelReduce(pol, 0, _H * _W, 4096, V{}, [&](const size_t lo, const size_t hi) {
+			return pairwiseSum<V>(lo, hi, [&](const size_t k) { const V a = abs(elem(k)); return a * a; });
+		}, std::plus<V>()));
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrix<T, _H, _W, _L>::dot(const matrix<U, _H, _W, _M>& x, const execution pol) const {
+		using V = decltype(T() * U());
+		return parallelReduce(pol, 0, _H * _W, 4096, V{}, [&](const size_t lo, const size_t hi) {
+			return pairwiseSum<V>(lo, hi, [&](const size_t k) {
+				if constexpr (sameStorage<matrix<T, _H, _W, _L>, matrix<U, _H, _W, _M>>) return elem(k) * x.elem(k);
+				else if constexpr (_L::column) return elem(k) * x.at(k % length, k / length);
+				else return elem(k) * x.at(k / length, k % length);
+			});
+		}, std::plus<V>());
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, _MX_SIZE_T_ _V, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrix<T, _H, _W, _L>::mul(const matrix<U, _W, _V, _M>& x, const execution pol) const {
+		using V = decltype(T()* U());
+		if constexpr (_H <= 4 && _W <= 4 && _V <= 4) return *this * x;
+		matrix<V, _H, _V, _L> res;
+		parallelFor(pol, 0, res.lines, std::max<size_t>(1, 4096 / ((size_t)_W * res.length)), [&](const size_t lo, const size_t hi) {
+			mulLines(*this, x, res, lo, hi);
+		});
 		return res;
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator matrix<T, _H, _W>::begin() {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline T* matrix<T, _H, _W, _L>::data() {
+		return buf[0].data();
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline const T* matrix<T, _H, _W, _L>::data() const {
+		return buf[0].data();
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline std::array<T, matrix<T, _H, _W, _L>::stride>& matrix<T, _H, _W, _L>::line(const size_t& l) {
+		return buf[l];
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const std::array<T, matrix<T, _H, _W, _L>::stride>& matrix<T, _H, _W, _L>::line(const size_t& l) const {
+		return buf[l];
+	}
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::iterator matrix<T, _H, _W, _L>::begin() {
 		return buf.begin();
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator matrix<T, _H, _W>::end() {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::iterator matrix<T, _H, _W, _L>::end() {
 		return buf.end();
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator matrix<T, _H, _W>::rbegin() {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::iterator matrix<T, _H, _W, _L>::rbegin() {
 		return buf.rbegin();
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::iterator matrix<T, _H, _W>::rend() {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::iterator matrix<T, _H, _W, _L>::rend() {
 		return buf.rend();
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator matrix<T, _H, _W>::begin() const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::const_iterator matrix<T, _H, _W, _L>::begin() const {
 		return buf.begin();
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator matrix<T, _H, _W>::end() const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::const_iterator matrix<T, _H, _W, _L>::end() const {
 		return buf.end();
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator matrix<T, _H, _W>::rbegin() const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::const_iterator matrix<T, _H, _W, _L>::rbegin() const {
 		return buf.rbegin();
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] inline typename std::array<std::array<T, _W>, _H>::const_iterator matrix<T, _H, _W>::rend() const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] inline typename matrix<T, _H, _W, _L>::storage::const_iterator matrix<T, _H, _W, _L>::rend() const {
 		return buf.rend();
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline std::array<T, _W>& matrix<T, _H, _W>::operator[](const _MX_SIZE_T_& h) {
-		return buf[h];
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline typename matrix<T, _H, _W, _L>::reference matrix<T, _H, _W, _L>::operator[](const _MX_SIZE_T_& h) {
+		if constexpr (_L::column) return reference(&buf, h);
+		else return buf[h];
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const std::array<T, _W>& matrix<T, _H, _W>::operator[](const _MX_SIZE_T_& h) const {
-		return buf[h];
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline typename matrix<T, _H, _W, _L>::const_reference matrix<T, _H, _W, _L>::operator[](const _MX_SIZE_T_& h) const {
+		if constexpr (_L::column) return const_reference(&buf, h);
+		else return buf[h];
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool matrix<T, _H, _W>::operator==(const matrix<U, _H, _W>& x) const {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				if (buf[i][j] == x[i][j]) return false;
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& matrix<T, _H, _W, _L>::operator()(const _MX_SIZE_T_& i, const _MX_SIZE_T_& j) {
+		return at(i, j);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& matrix<T, _H, _W, _L>::operator()(const _MX_SIZE_T_& i, const _MX_SIZE_T_& j) const {
+		return at(i, j);
+	}
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool matrix<T, _H, _W, _L>::operator==(const matrix<U, _H, _W, _M>& x) const {
+		if constexpr (sameStorage<matrix<T, _H, _W, _L>, matrix<U, _H, _W, _M>>) {
+			for (size_t l = 0; l < lines; l++)
+				for (size_t k = 0; k < length; k++)
+					if (buf[l][k] != x.buf[l][k]) return false;
+		}
+		else {
+			for (size_t i = 0; i < _H; i++)
+				for (size_t j = 0; j < _W; j++)
+					if (at(i, j) != x.at(i, j)) return false;
+		}
 		return true;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool matrix<T, _H, _W>::operator!=(const matrix<U, _H, _W>& x) const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool matrix<T, _H, _W, _L>::operator!=(const matrix<U, _H, _W, _M>& x) const {
 		return !(*this == x);
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& matrix<T, _H, _W>::operator=(const matrix<U, _H, _W>& x) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] = x[i][j];
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& matrix<T, _H, _W, _L>::operator=(const matrix<U, _H, _W, _M>& x) {
+		if constexpr (sameStorage<matrix<T, _H, _W, _L>, matrix<U, _H, _W, _M>>) {
+			for (size_t l = 0; l < lines; l++)
+				for (size_t k = 0; k < stride; k++)
+					buf[l][k] = x.buf[l][k];
+		}
+		else {
+			for (size_t i = 0; i < _H; i++)
+				for (size_t j = 0; j < _W; j++)
+					at(i, j) = x.at(i, j);
+		}
 		return *this;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& matrix<T, _H, _W>::operator+=(const matrix<U, _H, _W>& x) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] += x[i][j];
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& matrix<T, _H, _W, _L>::operator+=(const matrix<U, _H, _W, _M>& x) {
+		if constexpr (sameStorage<matrix<T, _H, _W, _L>, matrix<U, _H, _W, _M>>) {
+			for (size_t l = 0; l < lines; l++)
+				for (size_t k = 0; k < stride; k++)
+					buf[l][k] += x.buf[l][k];
+		}
+		else {
+			for (size_t i = 0; i < _H; i++)
+				for (size_t j = 0; j < _W; j++)
+					at(i, j) += x.at(i, j);
+		}
 		return *this;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& matrix<T, _H, _W>::operator-=(const matrix<U, _H, _W>& x) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] -= x[i][j];
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& matrix<T, _H, _W, _L>::operator-=(const matrix<U, _H, _W, _M>& x) {
+		if constexpr (sameStorage<matrix<T, _H, _W, _L>, matrix<U, _H, _W, _M>>) {
+			for (size_t l = 0; l < lines; l++)
+				for (size_t k = 0; k < stride; k++)
+					buf[l][k] -= x.buf[l][k];
+		}
+		else {
+			for (size_t i = 0; i < _H; i++)
+				for (size_t j = 0; j < _W; j++)
+					at(i, j) -= x.at(i, j);
+		}
 		return *this;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& matrix<T, _H, _W>::operator*=(const U& x) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] *= x;
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& matrix<T, _H, _W, _L>::operator*=(const U& x) {
+		for (size_t l = 0; l < lines; l++)
+			for (size_t k = 0; k < length; k++)
+				buf[l][k] *= x;
 		return *this;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& matrix<T, _H, _W>::operator*=(const sqMatrix<U, _W>& x) {
-		matrix<T, _H, _W> tmp;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				for (_MX_SIZE_T_ k = 0; k < _W; k++)
-					tmp[i, j] += buf[i][k] * x[k][j];
-		return *this = tmp;
-	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W>& matrix<T, _H, _W>::operator/=(const U& x) {
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				buf[i][j] /= x;
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& matrix<T, _H, _W, _L>::operator*=(const sqMatrix<U, _W, _M>& x) {
+		return *this = *this * x;
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API constexpr inline matrix<T, _H, _W, _L>& matrix<T, _H, _W, _L>::operator/=(const U& x) {
+		for (size_t l = 0; l < lines; l++)
+			for (size_t k = 0; k < length; k++)
+				buf[l][k] /= x;
 		return *this;
 	}
 
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W>::operator+(const matrix<U, _H, _W>& x) const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W, _L>::operator+(const matrix<U, _H, _W, _M>& x) const {
 		using V = decltype(T() + U());
-		matrix<V, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				res[i][j] = buf[i][j] + x[i][j];
-		return res;
+		matrix<V, _H, _W, _L> res = *this;
+		return res += x;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W>::operator-(const matrix<U, _H, _W>& x) const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W, _L>::operator-(const matrix<U, _H, _W, _M>& x) const {
 		using V = decltype(T() - U());
-		matrix<V, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				res[i][j] = buf[i][j] - x[i][j];
-		return res;
+		matrix<V, _H, _W, _L> res = *this;
+		return res -= x;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W>::operator*(const U& x) const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W, _L>::operator*(const U& x) const {
 		using V = decltype(T()* U());
-		matrix<V, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				res[i][j] = buf[i][j] * x;
-		return res;
+		matrix<V, _H, _W, _L> res = *this;
+		return res *= x;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U, _MX_SIZE_T_ _V>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W>::operator*(const matrix<U, _W, _V>& x) const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, _MX_SIZE_T_ _V, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W, _L>::operator*(const matrix<U, _W, _V, _M>& x) const {
 		using V = decltype(T()* U());
-		matrix<V, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _V; j++)
-				for (_MX_SIZE_T_ k = 0; k < _W; k++)
-					res[i][j] += buf[i][k] * x[k][j];
+		matrix<V, _H, _V, _L> res;
+		if constexpr (_H <= 4 && _W <= 4 && _V <= 4) {
+			unroll<_H>([&](auto i) {
+				unroll<_V>([&](auto j) {
+					res.at(i, j) = [&]<size_t... K>(std::index_sequence<K...>) {
+						return (... + (at(i, K) * x.at(K, j)));
+					}(std::make_index_sequence<_W>());
+				});
+			});
+		}
+		else mulLines(*this, x, res, 0, res.lines);
 		return res;
 	}
-	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W>::operator/(const U& x) const {
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U, _MX_SIZE_T_ _V, typename _M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W, _L>::operator*(const transView<matrix<U, _V, _W, _M>>& x) const {
 		using V = decltype(T()* U());
-		matrix<V, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				res[i][j] = buf[i][j] / x;
+		const matrix<U, _V, _W, _M>& b = x.base();
+		matrix<V, _H, _V, _L> res;
+		for (size_t i = 0; i < _H; i++)
+			for (size_t j = 0; j < _V; j++) {
+				V s = 0;
+				for (size_t k = 0; k < _W; k++)
+					s += at(i, k) * b.at(j, k);
+				res.at(i, j) = s;
+			}
 		return res;
 	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto matrix<T, _H, _W, _L>::operator/(const U& x) const {
+		using V = decltype(T()* U());
+		matrix<V, _H, _W, _L> res = *this;
+		return res /= x;
+	}
 
-	template<typename U, typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const U& x, const matrix<T, _H, _W>& m) {
+	template<typename U, typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto operator*(const U& x, const matrix<T, _H, _W, _L>& m) {
 		using V = decltype(U()* T());
-		matrix<V, _H, _W> res;
-		for (_MX_SIZE_T_ i = 0; i < _H; i++)
-			for (_MX_SIZE_T_ j = 0; j < _W; j++)
-				res[i][j] = x * m[i][j];
+		matrix<V, _H, _W, _L> res = m;
+		for (size_t l = 0; l < res.lines; l++)
+			for (size_t k = 0; k < res.length; k++)
+				res.line(l)[k] = x * res.line(l)[k];
 		return res;
 	}
 
-	template<typename T, _MX_SIZE_T_ _N>
-	MATHPLUSPLUS_API constexpr sqMatrix<T, _N>::sqMatrix() : matrix<T, _N, _N>() {}
-	template<typename T, _MX_SIZE_T_ _N>
-	template<typename U>
-	MATHPLUSPLUS_API constexpr sqMatrix<T, _N>::sqMatrix(const std::array<std::array<U, _N>, _N>& buff) : matrix<T, _N, _N>(buff) {}
-	template<typename T, _MX_SIZE_T_ _N>
+	template<typename M>
+	MATHPLUSPLUS_API constexpr transView<M>::transView(const M& x) : m(&x) {}
+
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const M& transView<M>::base() const {
+		return *m;
+	}
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const size_t transView<M>::height() const {
+		return m->width();
+	}
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const size_t transView<M>::width() const {
+		return m->height();
+	}
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto transView<M>::eval() const {
+		return m->trans();
+	}
+	template<typename M>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void transView<M>::apply(const std::vector<U>& x, std::vector<V>& y, const execution pol) const {
+		if constexpr (requires { m->applyTrans(x, y, pol); }) m->applyTrans(x, y, pol);
+		else {
+			y.assign(width(), V(0));
+			for (size_t k = 0; k < height(); k++)
+				for (size_t i = 0; i < width(); i++)
+					y[i] += (*m)(k, i) * x[k];
+		}
+	}
+
+	template<typename M>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto transView<M>::operator()(const size_t& i, const size_t& j) const {
+		return (*m)(j, i);
+	}
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API constexpr sqMatrix<T, _N, _L>::sqMatrix() : matrix<T, _N, _N, _L>() {}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
 	template<typename U>
-	MATHPLUSPLUS_API constexpr sqMatrix<T, _N>::sqMatrix(const std::initializer_list<std::initializer_list<U>>& buff) : matrix<T, _N, _N>(buff) {}
-	template<typename T, _MX_SIZE_T_ _N>
+	MATHPLUSPLUS_API constexpr sqMatrix<T, _N, _L>::sqMatrix(const std::array<std::array<U, _N>, _N>& buff) : matrix<T, _N, _N, _L>(buff) {}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
 	template<typename U>
-	MATHPLUSPLUS_API constexpr sqMatrix<T, _N>::sqMatrix(const sqMatrix<U, _N>& x) : matrix<T, _N, _N>(x) {}
-
-	template<typename T, _MX_SIZE_T_ _N>
-	MATHPLUSPLUS_API constexpr inline const sqMatrix<T, _N> sqMatrix<T, _N>::trans() {
-		sqMatrix<T, _N> res;
-		for (_MX_SIZE_T_ i = 0; i < _N; i++)
-			for (_MX_SIZE_T_ j = 0; j < _N; j++)
-				res[i][j] = matrix<T, _N, _N>::buf[j][i];
-		return res;
+	MATHPLUSPLUS_API constexpr sqMatrix<T, _N, _L>::sqMatrix(const std::initializer_list<std::initializer_list<U>>& buff) : matrix<T, _N, _N, _L>(buff) {}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	template<typename U, typename _M>
+	MATHPLUSPLUS_API constexpr sqMatrix<T, _N, _L>::sqMatrix(const sqMatrix<U, _N, _M>& x) : matrix<T, _N, _N, _L>(x) {}
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const sqMatrix<T, _N, _L> sqMatrix<T, _N, _L>::trans() const {
+		sqMatrix<T, _N, _L> res = *this;
+		return res.transpose();
+	}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API constexpr inline sqMatrix<T, _N, _L>& sqMatrix<T, _N, _L>::transpose() {
+		auto& buf = matrix<T, _N, _N, _L>::buf;
+		if constexpr (_N <= 4) {
+			unroll<_N>([&](auto i) {
+				unroll<_N>([&](auto j) {
+					if constexpr (i < j) std::swap(buf[i][j], buf[j][i]);
+				});
+			});
+		}
+		else if (std::is_constant_evaluated() || _N < 8) {
+			for (size_t i = 0; i < _N; i++)
+				for (size_t j = i + 1; j < _N; j++)
+					std::swap(buf[i][j], buf[j][i]);
+		}
+		else transInPlace(buf[0].data(), matrix<T, _N, _N, _L>::stride, _N);
+		return *this;
+	}
+
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T sqMatrix<T, _N, _L>::det() const {
+		const sqMatrix<T, _N, _L>& m = *this;
+		if constexpr (_N == 1) return m(0, 0);
+		else if constexpr (_N == 2) return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+		else if constexpr (_N == 3)
+			return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1))
+				- m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0))
+				+ m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+		else if constexpr (_N == 4) {
+			const T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1), s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+			const T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3), s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+			const T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3), s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+			const T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1), c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+			const T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3), c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+			const T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3), c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+			return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		}
+		else if constexpr (isExactType<T>::value) return detCRT(*this);
+		else {
+			sqMatrix<T, _N, _L> tmp = *this;
+			short s = 1;
+			T res = 1;
+			for (size_t i = 0; i + 1 < _N; i++) {
+				size_t piv = i;
+				for (size_t j = i; j < _N; j++)
+					if (abs(tmp[i][j]) > abs(tmp[i][piv])) piv = j;
+				if (tmp[i][piv] == 0) return 0;
+				if (piv != i) {
+					for (size_t j = i; j < _N; j++)
+						std::swap(tmp[j][i], tmp[j][piv]);
+					s = 0 - s;
+				}
+				for (size_t j = i + 1; j < _N; j++) {
+					T d = tmp[j][i] / tmp[i][i];
+					for (size_t k = i; k < _N; k++)
+						tmp[j][k] -= tmp[i][k] * d;
+				}
+				res *= tmp[i][i];
+			}
+			return res * tmp[_N - 1][_N - 1] * s;
+		}
+	}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const T sqMatrix<T, _N, _L>::det(const execution pol) const {
+		if constexpr (_N <= 4) return det();
+		else if constexpr (isExactType<T>::value) return detCRT(*this, pol);
+		else {
+			sqMatrix<T, _N, _L> tmp = *this;
+			T res = 1;
+			for (size_t i = 0; i < _N; i++) {
+				size_t piv = i;
+				for (size_t j = i + 1; j < _N; j++)
+					if (abs(tmp[j][i]) > abs(tmp[piv][i])) piv = j;
+				if (tmp[piv][i] == 0) return 0;
+				if (piv != i) {
+					if constexpr (_L::column) {
+						for (size_t k = 0; k < _N; k++)
+							std::swap(tmp(i, k), tmp(piv, k));
+					}
+					else std::swap(tmp.line(i), tmp.line(piv));
+					res = 0 - res;
+				}
+				res *= tmp[i][i];
+				parallelFor(pol, i + 1, _N, std::max<size_t>(1, 4096 / (_N - i)), [&](const size_t lo, const size_t hi) {
+					for (size_t j = lo; j < hi; j++) {
+						const T d = tmp[j][i] / tmp[i][i];
+						for (size_t k = i; k < _N; k++)
+							tmp[j][k] -= tmp[i][k] * d;
+					}
+				});
+			}
+			return res;
+		}
 	}
 
-	template<typename T, _MX_SIZE_T_ _N>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T sqMatrix<T, _N>::det() const {
-		sqMatrix<T, _N> tmp = *this;
-		short s = 1;
-		T res = 1;
-		for (_MX_SIZE_T_ i = 0; i + 1 < _N; i++) {
-			_MX_SIZE_T_ piv = i;
-			for (short j = i; j < _N; j++)
-				if (abs(tmp[i][j]) > abs(tmp[i][piv])) piv = j;
-			if (tmp[i][piv] == 0) return 0;
-			if (piv != i) {
-				for (short j = i; j < _N; j++)
-					std::swap(tmp[j][i], tmp[j][piv]);
-				s = 0 - s;
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const sqMatrix<T, _N, _L> sqMatrix<T, _N, _L>::inv() const {
+		const sqMatrix<T, _N, _L>& m = *this;
+		sqMatrix<T, _N, _L> res;
+		if constexpr (_N <= 4) {
+			const T d = det();
+			if (d == 0) throw singular_matrix();
+			if constexpr (_N == 1) res(0, 0) = T(1) / d;
+			else if constexpr (_N == 2) {
+				res(0, 0) = m(1, 1) / d;
+				res(0, 1) = -m(0, 1) / d;
+				res(1, 0) = -m(1, 0) / d;
+				res(1, 1) = m(0, 0) / d;
 			}
-			for (short j = i + 1; j < _N; j++) {
-				T d = tmp[j][i] / tmp[i][i];
-				for (short k = i; k < _N; k++)
-					tmp[j][k] -= tmp[i][k] * d;
+			else if constexpr (_N == 3) {
+				unroll<3>([&](auto i) {
+					unroll<3>([&](auto j) {
+						constexpr size_t r0 = (j + 1) % 3, r1 = (j + 2) % 3, c0 = (i + 1) % 3, c1 = (i + 2) % 3;
+						res(i, j) = (m(r0, c0) * m(r1, c1) - m(r0, c1) * m(r1, c0)) / d;
+					});
+				});
+			}
+			else {
+				const T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1), s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+				const T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3), s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+				const T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3), s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+				const T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1), c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+				const T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3), c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+				const T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3), c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+				res(0, 0) = (m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3) / d;
+				res(0, 1) = (-m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3) / d;
+				res(0, 2) = (m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3) / d;
+				res(0, 3) = (-m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3) / d;
+				res(1, 0) = (-m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1) / d;
+				res(1, 1) = (m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1) / d;
+				res(1, 2) = (-m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1) / d;
+				res(1, 3) = (m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1) / d;
+				res(2, 0) = (m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0) / d;
+				res(2, 1) = (-m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0) / d;
+				res(2, 2) = (m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0) / d;
+				res(2, 3) = (-m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0) / d;
+				res(3, 0) = (-m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0) / d;
+				res(3, 1) = (m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0) / d;
+				res(3, 2) = (-m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0) / d;
+				res(3, 3) = (m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0) / d;
+			}
+			return res;
+		}
+		sqMatrix<T, _N, _L> a = m;
+		res = idMatrix();
+		for (size_t i = 0; i < _N; i++) {
+			size_t piv = i;
+			for (size_t j = i + 1; j < _N; j++)
+				if (abs(a(j, i)) > abs(a(piv, i))) piv = j;
+			if (a(piv, i) == 0) throw singular_matrix();
+			if (piv != i)
+				for (size_t k = 0; k < _N; k++) {
+					std::swap(a(i, k), a(piv, k));
+					std::swap(res(i, k), res(piv, k));
+				}
+			const T d = a(i, i);
+			for (size_t k = 0; k < _N; k++) {
+				a(i, k) /= d;
+				res(i, k) /= d;
+			}
+			for (size_t j = 0; j < _N; j++) {
+				const T f = a(j, i);
+				if (j == i || f == 0) continue;
+				for (size_t k = 0; k < _N; k++) {
+					a(j, k) -= f * a(i, k);
+					res(j, k) -= f * res(i, k);
+				}
 			}
-			res *= tmp[i][i];
 		}
-		return res * tmp[_N - 1][_N - 1] * s;
+		return res;
+	}
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const T sqMatrix<T, _N, _L>::trace() const {
+		using A = typename accumType<T>::type;
+		return T(pairwiseSum<A>(0, _N, [&](const size_t k) { return A(this->at(k, k)); }));
 	}
 
-	template<typename T, _MX_SIZE_T_ _N>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const sqMatrix<T, _N> sqMatrix<T, _N>::idMatrix() {
-		sqMatrix<T, _N> res;
-		for (_MX_SIZE_T_ i = 0; i < _N; i++)
+	template<typename T, _MX_SIZE_T_ _N, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const sqMatrix<T, _N, _L> sqMatrix<T, _N, _L>::idMatrix() {
+		sqMatrix<T, _N, _L> res;
+		for (size_t i = 0; i < _N; i++)
 			res[i][i] = 1;
 		return res;
 	}
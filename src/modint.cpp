@@ -0,0 +1,306 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "modint.h"
+
+namespace math {
+
+	MATHPLUSPLUS_API invalid_modulus::invalid_modulus() : std::runtime_error("Modulus of math::modint256 must be odd and greater than 1") {}
+
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint32_t modint<_P>::reduce(const uint64_t t) {
+		const uint32_t m = (uint32_t)t * nInv;
+		const uint32_t u = (uint32_t)((t + (uint64_t)m * _P) >> 32);
+		return u >= _P ? u - _P : u;
+	}
+
+	template<uint32_t _P>
+	MATHPLUSPLUS_API constexpr modint<_P>::modint() : v(0) {}
+	template<uint32_t _P>
+	template<typename I> requires std::is_integral_v<I>
+	MATHPLUSPLUS_API constexpr modint<_P>::modint(const I x) {
+		uint32_t r;
+		if constexpr (std::is_signed_v<I>) {
+			const int64_t s = (int64_t)x % (int64_t)_P;
+			r = (uint32_t)(s < 0 ? s + _P : s);
+		}
+		else
+			r = (uint32_t)((uint64_t)x % _P);
+		v = reduce((uint64_t)r * r2);
+	}
+
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint32_t modint<_P>::modulus() {
+		return _P;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const uint32_t modint<_P>::value() const {
+		return reduce(v);
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> modint<_P>::pow(uint64_t e) const {
+		modint<_P> res(1), b(*this);
+		for (; e; e >>= 1, b *= b)
+			if (e & 1) res *= b;
+		return res;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> modint<_P>::inv() const {
+		return pow(_P - 2);
+	}
+
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr modint<_P>::operator uint32_t() const {
+		return value();
+	}
+
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool modint<_P>::operator==(const modint<_P>& x) const {
+		return v == x.v;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const bool modint<_P>::operator!=(const modint<_P>& x) const {
+		return v != x.v;
+	}
+
+	template<uint32_t _P>
+	MATHPLUSPLUS_API constexpr inline modint<_P>& modint<_P>::operator+=(const modint<_P>& x) {
+		v += x.v;
+		if (v >= _P) v -= _P;
+		return *this;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API constexpr inline modint<_P>& modint<_P>::operator-=(const modint<_P>& x) {
+		v = v >= x.v ? v - x.v : v + _P - x.v;
+		return *this;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API constexpr inline modint<_P>& modint<_P>::operator*=(const modint<_P>& x) {
+		v = reduce((uint64_t)v * x.v);
+		return *this;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API constexpr inline modint<_P>& modint<_P>::operator/=(const modint<_P>& x) {
+		return *this *= x.inv();
+	}
+
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> modint<_P>::operator-() const {
+		modint<_P> res;
+		res.v = v == 0 ? 0 : _P - v;
+		return res;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> modint<_P>::operator+(const modint<_P>& x) const {
+		modint<_P> res(*this);
+		return res += x;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> modint<_P>::operator-(const modint<_P>& x) const {
+		modint<_P> res(*this);
+		return res -= x;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> modint<_P>::operator*(const modint<_P>& x) const {
+		modint<_P> res(*this);
+		return res *= x;
+	}
+	template<uint32_t _P>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const modint<_P> modint<_P>::operator/(const modint<_P>& x) const {
+		modint<_P> res(*this);
+		return res /= x;
+	}
+
+	template<size_t _I>
+	typename modint256<_I>::context modint256<_I>::ctx{};
+
+	template<size_t _I>
+	MATHPLUSPLUS_API void modint256<_I>::montMul(const std::array<uint32_t, 8>& a, const std::array<uint32_t, 8>& b, std::array<uint32_t, 8>& out) {
+		// The accumulator t runs from the lowest limb up, while the operands are big-endian like uint256_t.
+		uint32_t t[10] = {};
+		for (size_t i = 0; i < 8; i++) {
+			uint64_t c = 0;
+			for (size_t j = 0; j < 8; j++) {
+				c += (uint64_t)t[j] + (uint64_t)a[7 - j] * b[7 - i];
+				t[j] = (uint32_t)c;
+				c >>= 32;
+			}
+			c += t[8];
+			t[8] = (uint32_t)c;
+			t[9] = (uint32_t)(c >> 32);
+			// Add m n so the lowest limb vanishes, then shift down by one limb.
+			const uint32_t m = t[0] * ctx.nInv;
+			c = ((uint64_t)t[0] + (uint64_t)m * ctx.n[7]) >> 32;
+			for (size_t j = 1; j < 8; j++) {
+				c += (uint64_t)t[j] + (uint64_t)m * ctx.n[7 - j];
+				t[j - 1] = (uint32_t)c;
+				c >>= 32;
+			}
+			c += t[8];
+			t[7] = (uint32_t)c;
+			t[8] = t[9] + (uint32_t)(c >> 32);
+		}
+		for (size_t i = 0; i < 8; i++)
+			out[7 - i] = t[i];
+		if (t[8] || !limbLess(out, ctx.n)) limbSub(out, ctx.n);
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const std::array<uint32_t, 8> modint256<_I>::limbs(const uint256_t& x) {
+		std::array<uint32_t, 8> res;
+		for (size_t i = 0; i < 8; i++)
+			res[7 - i] = (uint32_t)(x >> (int)(32 * i));
+		return res;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const uint256_t modint256<_I>::join(const std::array<uint32_t, 8>& x) {
+		uint256_t res;
+		for (size_t i = 0; i < 8; i++)
+			res = (res << 32) | uint256_t((uint64_t)x[i]);
+		return res;
+	}
+
+	template<size_t _I>
+	MATHPLUSPLUS_API void modint256<_I>::setModulus(const uint256_t& n) {
+		// Montgomery reduction needs n invertible modulo 2^32, and the doubling below needs 1 < n.
+		const std::array<uint32_t, 8> l = limbs(n), unit{ 0, 0, 0, 0, 0, 0, 0, 1 };
+		if (!(l[7] & 1) || !limbLess(unit, l)) throw invalid_modulus();
+		ctx.modulus = n;
+		ctx.n = l;
+		uint32_t x = ctx.n[7];
+		for (int i = 0; i < 4; i++)
+			x *= 2 - ctx.n[7] * x;
+		ctx.nInv = 0u - x;
+		// 2^512 mod n by doubling, which avoids needing a 512-bit remainder.
+		std::array<uint32_t, 8> r = unit;
+		for (int i = 0; i < 512; i++) {
+			const uint32_t carry = limbAdd(r, r);
+			if (carry || !limbLess(r, ctx.n)) limbSub(r, ctx.n);
+		}
+		ctx.r2 = r;
+		montMul(unit, ctx.r2, ctx.one);
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const uint256_t modint256<_I>::modulus() {
+		return ctx.modulus;
+	}
+
+	template<size_t _I>
+	MATHPLUSPLUS_API modint256<_I>::modint256() : v{} {}
+	template<size_t _I>
+	template<typename I> requires std::is_integral_v<I>
+	MATHPLUSPLUS_API modint256<_I>::modint256(const I x) : modint256(uint256_t((uint64_t)(std::is_signed_v<I> && x < 0 ? -(x + 1) : x))) {
+		if constexpr (std::is_signed_v<I>)
+			if (x < 0) *this = -(*this + modint256<_I>(uint256_t((uint64_t)1)));
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API modint256<_I>::modint256(const uint256_t& x) {
+		montMul(limbs(x % ctx.modulus), ctx.r2, v);
+	}
+
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const uint256_t modint256<_I>::value() const {
+		std::array<uint32_t, 8> res;
+		montMul(v, std::array<uint32_t, 8>{ 0, 0, 0, 0, 0, 0, 0, 1 }, res);
+		return join(res);
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> modint256<_I>::pow(const uint256_t& e) const {
+		const std::array<uint32_t, 8> bits = limbs(e);
+		modint256<_I> res;
+		res.v = ctx.one;
+		for (size_t i = 256; i-- > 0;) {
+			res *= res;
+			if ((bits[7 - i / 32] >> (i % 32)) & 1) res *= *this;
+		}
+		return res;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> modint256<_I>::inv() const {
+		return pow(ctx.modulus - uint256_t((uint64_t)2));
+	}
+
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] inline const bool modint256<_I>::operator==(const modint256<_I>& x) const {
+		return v == x.v;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] inline const bool modint256<_I>::operator!=(const modint256<_I>& x) const {
+		return v != x.v;
+	}
+
+	template<size_t _I>
+	MATHPLUSPLUS_API modint256<_I>& modint256<_I>::operator+=(const modint256<_I>& x) {
+		const uint32_t carry = limbAdd(v, x.v);
+		if (carry || !limbLess(v, ctx.n)) limbSub(v, ctx.n);
+		return *this;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API modint256<_I>& modint256<_I>::operator-=(const modint256<_I>& x) {
+		if (limbSub(v, x.v)) limbAdd(v, ctx.n);
+		return *this;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API modint256<_I>& modint256<_I>::operator*=(const modint256<_I>& x) {
+		montMul(v, x.v, v);
+		return *this;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API modint256<_I>& modint256<_I>::operator/=(const modint256<_I>& x) {
+		return *this *= x.inv();
+	}
+
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> modint256<_I>::operator-() const {
+		modint256<_I> res;
+		return res -= *this;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> modint256<_I>::operator+(const modint256<_I>& x) const {
+		modint256<_I> res(*this);
+		return res += x;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> modint256<_I>::operator-(const modint256<_I>& x) const {
+		modint256<_I> res(*this);
+		return res -= x;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> modint256<_I>::operator*(const modint256<_I>& x) const {
+		modint256<_I> res(*this);
+		return res *= x;
+	}
+	template<size_t _I>
+	MATHPLUSPLUS_API [[nodiscard]] const modint256<_I> modint256<_I>::operator/(const modint256<_I>& x) const {
+		modint256<_I> res(*this);
+		return res /= x;
+	}
+}
@@ -0,0 +1,270 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace math {
+
+	static thread_local const threadPool* currentPool = nullptr;
+	static thread_local size_t currentId = SIZE_MAX;
+	static thread_local std::vector<const threadPool*> heldPools;
+
+	MATHPLUSPLUS_API busy_thread_pool::busy_thread_pool() : std::runtime_error("math::threadPool cannot be resized from inside a parallel region") {}
+
+	MATHPLUSPLUS_API threadPool::threadPool(const size_t n) : stop(false), pending(0), next(0), regions(0), resizing(false) {
+		start(n);
+	}
+	MATHPLUSPLUS_API threadPool::~threadPool() {
+		shutdown();
+	}
+
+	MATHPLUSPLUS_API void threadPool::start(const size_t n) {
+		size_t count = n ? n : std::thread::hardware_concurrency();
+		if (count == 0) count = 1;
+		stop = false;
+		// The thread that waits on a parallel region works as well, so n threads means n - 1 workers.
+		for (size_t i = 0; i + 1 < count; i++)
+			queues.push_back(std::make_unique<queue>());
+		for (size_t i = 0; i + 1 < count; i++)
+			workers.emplace_back(&threadPool::run, this, i);
+	}
+	MATHPLUSPLUS_API void threadPool::shutdown() {
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			stop = true;
+		}
+		sleep.notify_all();
+		for (auto& t : workers)
+			t.join();
+		workers.clear();
+		queues.clear();
+	}
+
+	MATHPLUSPLUS_API void threadPool::run(const size_t id) {
+		currentPool = this;
+		currentId = id;
+		std::function<void()> task;
+		while (true) {
+			if (take(id, task)) {
+				task();
+				task = nullptr;
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleep.wait(lock, [this] { return stop || pending > 0; });
+			if (stop && pending == 0) return;
+		}
+	}
+	MATHPLUSPLUS_API [[nodiscard]] const bool threadPool::take(const size_t id, std::function<void()>& task) {
+		const size_t n = queues.size();
+		if (n == 0 || pending == 0) return false;
+		if (id < n) {
+			std::lock_guard<std::mutex> lock(queues[id]->m);
+			if (!queues[id]->tasks.empty()) {
+				task = std::move(queues[id]->tasks.back());
+				queues[id]->tasks.pop_back();
+				pending--;
+				return true;
+			}
+		}
+		const size_t first = id < n ? id + 1 : 0;
+		for (size_t k = 0; k < n; k++) {
+			queue& q = *queues[(first + k) % n];
+			std::lock_guard<std::mutex> lock(q.m);
+			if (!q.tasks.empty()) {
+				task = std::move(q.tasks.front());
+				q.tasks.pop_front();
+				pending--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	MATHPLUSPLUS_API threadPool::region::region(threadPool& p) : pool(p), owner(false) {
+		// Workers run inside a region already, and a nested region on the same thread must not wait for a pending resize.
+		if (currentPool == &pool || std::find(heldPools.begin(), heldPools.end(), &pool) != heldPools.end()) return;
+		std::unique_lock<std::mutex> lock(pool.regionMutex);
+		pool.regionIdle.wait(lock, [this] { return !pool.resizing; });
+		pool.regions++;
+		heldPools.push_back(&pool);
+		owner = true;
+	}
+	MATHPLUSPLUS_API threadPool::region::~region() {
+		if (!owner) return;
+		heldPools.erase(std::find(heldPools.begin(), heldPools.end(), &pool));
+		std::lock_guard<std::mutex> lock(pool.regionMutex);
+		if (--pool.regions == 0) pool.regionIdle.notify_all();
+	}
+
+	MATHPLUSPLUS_API void threadPool::resize(const size_t n) {
+		if (currentPool == this || std::find(heldPools.begin(), heldPools.end(), this) != heldPools.end())
+			throw busy_thread_pool();
+		// New regions are held back and running ones finish, so the queues are drained and no caller touches them while they are rebuilt.
+		std::unique_lock<std::mutex> lock(regionMutex);
+		regionIdle.wait(lock, [this] { return !resizing; });
+		resizing = true;
+		regionIdle.wait(lock, [this] { return regions == 0; });
+		shutdown();
+		start(n);
+		resizing = false;
+		lock.unlock();
+		regionIdle.notify_all();
+	}
+	MATHPLUSPLUS_API [[nodiscard]] const size_t threadPool::size() const {
+		return workers.size() + 1;
+	}
+	MATHPLUSPLUS_API void threadPool::submit(std::function<void()> task) {
+		region guard(*this);
+		if (queues.empty()) {
+			task();
+			return;
+		}
+		const size_t id = currentPool == this ? currentId : next++ % queues.size();
+		{
+			// pending is published only once the task can be taken, and under sleepMutex so a worker between its check and its wait cannot miss it.
+			std::lock_guard<std::mutex> lock(queues[id]->m);
+			queues[id]->tasks.push_back(std::move(task));
+			std::lock_guard<std::mutex> wake(sleepMutex);
+			pending++;
+		}
+		sleep.notify_one();
+	}
+	MATHPLUSPLUS_API const bool threadPool::runPending() {
+		region guard(*this);
+		std::function<void()> task;
+		if (!take(currentPool == this ? currentId : SIZE_MAX, task)) return false;
+		task();
+		return true;
+	}
+
+	MATHPLUSPLUS_API [[nodiscard]] threadPool& threadPool::global() {
+		static threadPool pool;
+		return pool;
+	}
+
+	MATHPLUSPLUS_API void setThreadCount(const size_t n) {
+		threadPool::global().resize(n);
+	}
+	MATHPLUSPLUS_API [[nodiscard]] const size_t threadCount() {
+		return threadPool::global().size();
+	}
+
+	template<typename F>
+	MATHPLUSPLUS_API void parallelFor(const execution pol, const size_t begin, const size_t end, const size_t grain, F&& f) {
+		if (end <= begin) return;
+		threadPool& pool = threadPool::global();
+		const size_t n = end - begin, g = grain ? grain : 1;
+		if (pol == execution::seq || n <= g) {
+			f(begin, end);
+			return;
+		}
+		threadPool::region guard(pool);
+		if (pool.size() < 2) {
+			f(begin, end);
+			return;
+		}
+		const size_t chunks = std::min((n + g - 1) / g, pool.size() * 4);
+		const size_t step = (n + chunks - 1) / chunks;
+		std::atomic<size_t> left(chunks);
+		std::exception_ptr err;
+		std::mutex errMutex;
+		auto chunk = [&](const size_t lo, const size_t hi) {
+			try {
+				if (lo < hi) f(lo, hi);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(errMutex);
+				if (!err) err = std::current_exception();
+			}
+			left--;
+		};
+		for (size_t c = 1; c < chunks; c++) {
+			const size_t lo = std::min(end, begin + c * step), hi = std::min(end, lo + step);
+			pool.submit([&chunk, lo, hi] { chunk(lo, hi); });
+		}
+		chunk(begin, std::min(end, begin + step));
+		while (left > 0)
+			if (!pool.runPending()) std::this_thread::yield();
+		if (err) std::rethrow_exception(err);
+	}
+
+	template<typename F>
+	MATHPLUSPLUS_API void parallelFor2d(const execution pol, const size_t rows, const size_t cols, const size_t tile, F&& f) {
+		const size_t t = tile ? tile : 1;
+		const size_t tr = (rows + t - 1) / t, tc = (cols + t - 1) / t;
+		parallelFor(pol, 0, tr * tc, 1, [&](const size_t lo, const size_t hi) {
+			for (size_t k = lo; k < hi; k++) {
+				const size_t r = (k / tc) * t, c = (k % tc) * t;
+				f(r, std::min(rows, r + t), c, std::min(cols, c + t));
+			}
+		});
+	}
+
+	template<typename T, typename F>
+	MATHPLUSPLUS_API [[nodiscard]] const T pairwiseSum(const size_t begin, const size_t end, F&& f) {
+		const size_t n = end - begin;
+		if (end <= begin) return T{};
+		if (n > 128) {
+			const size_t mid = begin + n / 2;
+			return pairwiseSum<T>(begin, mid, f) + pairwiseSum<T>(mid, end, f);
+		}
+		// Independent lanes keep the leaf loop free of a serial dependency so it vectorizes.
+		T acc[8] = {};
+		size_t k = begin;
+		for (; k + 8 <= end; k += 8)
+			for (size_t l = 0; l < 8; l++)
+				acc[l] += f(k + l);
+		for (size_t l = 0; k < end; k++, l++)
+			acc[l] += f(k);
+		return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+	}
+
+	template<typename T, typename F, typename R>
+	MATHPLUSPLUS_API [[nodiscard]] const T parallelReduce(const execution pol, const size_t begin, const size_t end, const size_t grain, const T& init, F&& f, R&& op) {
+		if (end <= begin) return init;
+		// Blocks depend only on the grain, not on the thread count, so the result is the same for every policy.
+		const size_t g = grain ? grain : 1, blocks = (end - begin + g - 1) / g;
+		std::vector<T> part(blocks, init);
+		parallelFor(pol, 0, blocks, 1, [&](const size_t lo, const size_t hi) {
+			for (size_t b = lo; b < hi; b++)
+				part[b] = f(begin + b * g, std::min(end, begin + (b + 1) * g));
+		});
+		for (size_t span = 1; span < blocks; span *= 2)
+			for (size_t b = 0; b + span < blocks; b += 2 * span)
+				part[b] = op(part[b], part[b + span]);
+		return op(init, part[0]);
+	}
+}
@@ -32,11 +32,708 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "polynom.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdint.h>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define _PL_AVX2_
+#endif // AVX2
+#if defined(__AVX512F__)
+#define _PL_AVX512_
+#endif // AVX-512
+
 namespace math {
 
+	MATHPLUSPLUS_API length_mismatch::length_mismatch() : std::runtime_error("Lengths of math::polynom evaluation buffers do not match") {}
+
+	MATHPLUSPLUS_API zero_divisor::zero_divisor() : std::runtime_error("Division by the zero math::polynom") {}
+
+	MATHPLUSPLUS_API order_overflow::order_overflow() : std::runtime_error("Order of math::sparse_polynom exceeds the range of math::polynom") {}
+
+	MATHPLUSPLUS_API exponent_overflow::exponent_overflow() : std::runtime_error("Exponent exceeds the 64-bit range of math::sparse_polynom or the packed field of math::mpolynom") {}
+
+	template<typename V, typename T, typename U>
+	static constexpr inline const V hornerEval(const T* c, const _MX_SIZE_T_ n, const U& x) {
+		V res = c[n];
+		for (_MX_SIZE_T_ i = n; i-- > 0;)
+			res = res * x + c[i];
+		return res;
+	}
+
+	template<typename V, _MX_SIZE_T_ _N, typename T, typename U, _MX_SIZE_T_... _I>
+	static constexpr inline const V fixedHorner(const T* c, const U& x, std::index_sequence<_I...>) {
+		V res = c[_N];
+		((res = res * x + c[_N - 1 - _I]), ...);
+		return res;
+	}
+	template<typename V, _MX_SIZE_T_ _N, typename T, typename U>
+	static constexpr inline const V fixedHorner(const T* c, const U& x) {
+		return fixedHorner<V, _N>(c, x, std::make_index_sequence<_N>());
+	}
+
+	// Horner's rule run across points: every lane carries its own independent chain, so the dependency
+	// latency of one chain is hidden behind the others.
+	template<typename T>
+	static void hornerPoints(const T* c, const _MX_SIZE_T_ n, const T* x, T* y, const size_t m) {
+		size_t k = 0;
+#if defined(_PL_AVX512_)
+		if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+			constexpr size_t w = 64 / sizeof(T);
+			auto load = [](const T* p) { if constexpr (std::is_same_v<T, double>) return _mm512_loadu_pd(p); else return _mm512_loadu_ps(p); };
+			using R = decltype(load(x));
+			auto set = [](const T v) { if constexpr (std::is_same_v<T, double>) return _mm512_set1_pd(v); else return _mm512_set1_ps(v); };
+			auto fma = [](const R a, const R b, const R c) { if constexpr (std::is_same_v<T, double>) return _mm512_fmadd_pd(a, b, c); else return _mm512_fmadd_ps(a, b, c); };
+			auto store = [](T* p, const R v) { if constexpr (std::is_same_v<T, double>) _mm512_storeu_pd(p, v); else _mm512_storeu_ps(p, v); };
+			for (; k + 8 * w <= m; k += 8 * w) {
+				const R x0 = load(x + k), x1 = load(x + k + w), x2 = load(x + k + 2 * w), x3 = load(x + k + 3 * w);
+				const R x4 = load(x + k + 4 * w), x5 = load(x + k + 5 * w), x6 = load(x + k + 6 * w), x7 = load(x + k + 7 * w);
+				R r0 = set(c[n]), r1 = r0, r2 = r0, r3 = r0, r4 = r0, r5 = r0, r6 = r0, r7 = r0;
+				for (_MX_SIZE_T_ i = n; i-- > 0;) {
+					const R ci = set(c[i]);
+					r0 = fma(r0, x0, ci);
+					r1 = fma(r1, x1, ci);
+					r2 = fma(r2, x2, ci);
+					r3 = fma(r3, x3, ci);
+					r4 = fma(r4, x4, ci);
+					r5 = fma(r5, x5, ci);
+					r6 = fma(r6, x6, ci);
+					r7 = fma(r7, x7, ci);
+				}
+				store(y + k, r0);
+				store(y + k + w, r1);
+				store(y + k + 2 * w, r2);
+				store(y + k + 3 * w, r3);
+				store(y + k + 4 * w, r4);
+				store(y + k + 5 * w, r5);
+				store(y + k + 6 * w, r6);
+				store(y + k + 7 * w, r7);
+			}
+		}
+#elif defined(_PL_AVX2_)
+		if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+			constexpr size_t w = 32 / sizeof(T);
+			auto load = [](const T* p) { if constexpr (std::is_same_v<T, double>) return _mm256_loadu_pd(p); else return _mm256_loadu_ps(p); };
+			using R = decltype(load(x));
+			auto set = [](const T v) { if constexpr (std::is_same_v<T, double>) return _mm256_set1_pd(v); else return _mm256_set1_ps(v); };
+			auto fma = [](const R a, const R b, const R c) { if constexpr (std::is_same_v<T, double>) return _mm256_fmadd_pd(a, b, c); else return _mm256_fmadd_ps(a, b, c); };
+			auto store = [](T* p, const R v) { if constexpr (std::is_same_v<T, double>) _mm256_storeu_pd(p, v); else _mm256_storeu_ps(p, v); };
+			for (; k + 8 * w <= m; k += 8 * w) {
+				const R x0 = load(x + k), x1 = load(x + k + w), x2 = load(x + k + 2 * w), x3 = load(x + k + 3 * w);
+				const R x4 = load(x + k + 4 * w), x5 = load(x + k + 5 * w), x6 = load(x + k + 6 * w), x7 = load(x + k + 7 * w);
+				R r0 = set(c[n]), r1 = r0, r2 = r0, r3 = r0, r4 = r0, r5 = r0, r6 = r0, r7 = r0;
+				for (_MX_SIZE_T_ i = n; i-- > 0;) {
+					const R ci = set(c[i]);
+					r0 = fma(r0, x0, ci);
+					r1 = fma(r1, x1, ci);
+					r2 = fma(r2, x2, ci);
+					r3 = fma(r3, x3, ci);
+					r4 = fma(r4, x4, ci);
+					r5 = fma(r5, x5, ci);
+					r6 = fma(r6, x6, ci);
+					r7 = fma(r7, x7, ci);
+				}
+				store(y + k, r0);
+				store(y + k + w, r1);
+				store(y + k + 2 * w, r2);
+				store(y + k + 3 * w, r3);
+				store(y + k + 4 * w, r4);
+				store(y + k + 5 * w, r5);
+				store(y + k + 6 * w, r6);
+				store(y + k + 7 * w, r7);
+			}
+		}
+#endif
+		constexpr size_t lanes = 8;
+		for (; k + lanes <= m; k += lanes) {
+			T r[lanes];
+			for (size_t t = 0; t < lanes; t++)
+				r[t] = c[n];
+			for (_MX_SIZE_T_ i = n; i-- > 0;)
+				for (size_t t = 0; t < lanes; t++)
+					r[t] = r[t] * x[k + t] + c[i];
+			for (size_t t = 0; t < lanes; t++)
+				y[k + t] = r[t];
+		}
+		for (; k < m; k++)
+			y[k] = hornerEval<T>(c, n, x[k]);
+	}
+
+	// Complex points are split into real and imaginary lanes so the chains vectorize like real ones.
+	template<typename B, typename T>
+	static void hornerPointsCx(const T* c, const _MX_SIZE_T_ n, const complex<B>* x, complex<B>* y, const size_t m) {
+		auto re = [](const T& v) -> B { if constexpr (isComplex<T>::value) return v.re; else return v; };
+		auto im = [](const T& v) -> B { if constexpr (isComplex<T>::value) return v.im; else return B(0); };
+		constexpr size_t lanes = 8;
+		size_t k = 0;
+		for (; k + lanes <= m; k += lanes) {
+			B xr[lanes], xi[lanes], rr[lanes], ri[lanes];
+			for (size_t t = 0; t < lanes; t++) {
+				xr[t] = x[k + t].re;
+				xi[t] = x[k + t].im;
+				rr[t] = re(c[n]);
+				ri[t] = im(c[n]);
+			}
+			for (_MX_SIZE_T_ i = n; i-- > 0;) {
+				const B cr = re(c[i]), ci = im(c[i]);
+				for (size_t t = 0; t < lanes; t++) {
+					const B u = rr[t] * xr[t] - ri[t] * xi[t] + cr;
+					ri[t] = rr[t] * xi[t] + ri[t] * xr[t] + ci;
+					rr[t] = u;
+				}
+			}
+			for (size_t t = 0; t < lanes; t++)
+				y[k + t] = complex<B>(rr[t], ri[t]);
+		}
+		for (; k < m; k++)
+			y[k] = hornerEval<complex<B>>(c, n, x[k]);
+	}
+
+	template<typename T>
+	static void schoolbookMul(const T* a, const size_t na, const T* b, const size_t nb, T* out) {
+		for (size_t i = 0; i < na; i++) {
+			const T ai = a[i];
+			T* o = out + i;
+			for (size_t j = 0; j < nb; j++)
+				o[j] += ai * b[j];
+		}
+	}
+
+	// Equal-length Karatsuba; out must hold 2n - 1 zeroed coefficients and scratch 8n.
+	template<typename T>
+	static void karatsubaMul(const T* a, const T* b, const size_t n, T* out, T* scratch) {
+		if (n < karatsubaThreshold) {
+			schoolbookMul(a, n, b, n, out);
+			return;
+		}
+		const size_t m = n / 2, h = n - m;
+		T* sa = scratch, * sb = sa + h, * mid = sb + h, * next = mid + 2 * h - 1;
+		karatsubaMul(a, b, m, out, next);
+		karatsubaMul(a + m, b + m, h, out + 2 * m, next);
+		for (size_t i = 0; i < h; i++) {
+			sa[i] = a[m + i];
+			sb[i] = b[m + i];
+		}
+		for (size_t i = 0; i < m; i++) {
+			sa[i] += a[i];
+			sb[i] += b[i];
+		}
+		std::fill(mid, mid + 2 * h - 1, T(0));
+		karatsubaMul(sa, sb, h, mid, next);
+		for (size_t i = 0; i < 2 * m - 1; i++)
+			mid[i] -= out[i];
+		for (size_t i = 0; i < 2 * h - 1; i++)
+			mid[i] -= out[2 * m + i];
+		for (size_t i = 0; i < 2 * h - 1; i++)
+			out[m + i] += mid[i];
+	}
+
+	// Unbalanced operands are cut into pieces as long as the shorter one and accumulated.
+	template<typename T>
+	static void karatsubaMul(const T* a, size_t na, const T* b, size_t nb, T* out) {
+		if (na < nb) {
+			std::swap(a, b);
+			std::swap(na, nb);
+		}
+		std::vector<T> piece(2 * nb - 1), scratch(8 * nb + 64), pad(nb);
+		for (size_t k = 0; k < na; k += nb) {
+			const size_t len = std::min(nb, na - k);
+			const T* src = a + k;
+			if (len < nb) {
+				std::copy(src, src + len, pad.begin());
+				std::fill(pad.begin() + len, pad.end(), T(0));
+				src = pad.data();
+			}
+			std::fill(piece.begin(), piece.end(), T(0));
+			karatsubaMul(src, b, nb, piece.data(), scratch.data());
+			const size_t used = std::min(piece.size(), na + nb - 1 - k);
+			for (size_t i = 0; i < used; i++)
+				out[k + i] += piece[i];
+		}
+	}
+
+	// Iterative radix-2 transform on split real and imaginary arrays; w holds exp(-2 pi i k / n) for k < n / 2.
+	static void fftSplit(double* re, double* im, const size_t n, const double* wr, const double* wi, const bool inverse) {
+		for (size_t i = 1, j = 0; i < n; i++) {
+			size_t bit = n >> 1;
+			for (; j & bit; bit >>= 1)
+				j ^= bit;
+			j ^= bit;
+			if (i < j) {
+				std::swap(re[i], re[j]);
+				std::swap(im[i], im[j]);
+			}
+		}
+		for (size_t len = 2; len <= n; len <<= 1) {
+			const size_t half = len / 2, step = n / len;
+			for (size_t s = 0; s < n; s += len)
+				for (size_t k = 0; k < half; k++) {
+					const double cr = wr[k * step], ci = inverse ? -wi[k * step] : wi[k * step];
+					const size_t p = s + k, q = p + half;
+					const double tr = re[q] * cr - im[q] * ci, ti = re[q] * ci + im[q] * cr;
+					re[q] = re[p] - tr;
+					im[q] = im[p] - ti;
+					re[p] += tr;
+					im[p] += ti;
+				}
+		}
+		if (inverse)
+			for (size_t i = 0; i < n; i++) {
+				re[i] /= n;
+				im[i] /= n;
+			}
+	}
+
+	static void fftRoots(const size_t n, std::vector<double>& wr, std::vector<double>& wi) {
+		wr.resize(n / 2);
+		wi.resize(n / 2);
+		for (size_t k = 0; k < n / 2; k++) {
+			const double t = -6.283185307179586476925 * (double)k / (double)n;
+			wr[k] = std::cos(t);
+			wi[k] = std::sin(t);
+		}
+	}
+
+	template<typename T>
+	static void fftMul(const T* a, const size_t na, const T* b, const size_t nb, T* out) {
+		const size_t nc = na + nb - 1;
+		size_t n = 1;
+		while (n < nc)
+			n <<= 1;
+		std::vector<double> wr, wi;
+		fftRoots(n, wr, wi);
+		if constexpr (isComplex<T>::value) {
+			std::vector<double> ar(n), ai(n), br(n), bi(n);
+			for (size_t i = 0; i < na; i++) {
+				ar[i] = a[i].re;
+				ai[i] = a[i].im;
+			}
+			for (size_t i = 0; i < nb; i++) {
+				br[i] = b[i].re;
+				bi[i] = b[i].im;
+			}
+			fftSplit(ar.data(), ai.data(), n, wr.data(), wi.data(), false);
+			fftSplit(br.data(), bi.data(), n, wr.data(), wi.data(), false);
+			for (size_t k = 0; k < n; k++) {
+				const double r = ar[k] * br[k] - ai[k] * bi[k];
+				ai[k] = ar[k] * bi[k] + ai[k] * br[k];
+				ar[k] = r;
+			}
+			fftSplit(ar.data(), ai.data(), n, wr.data(), wi.data(), true);
+			for (size_t i = 0; i < nc; i++)
+				out[i] = T(ar[i], ai[i]);
+		}
+		else {
+			// Both real inputs share one transform as z = a + ib; A and B are separated by conjugate symmetry.
+			std::vector<double> zr(n), zi(n), cr(n), ci(n);
+			for (size_t i = 0; i < na; i++)
+				zr[i] = (double)a[i];
+			for (size_t i = 0; i < nb; i++)
+				zi[i] = (double)b[i];
+			fftSplit(zr.data(), zi.data(), n, wr.data(), wi.data(), false);
+			for (size_t k = 0; k < n; k++) {
+				const size_t j = (n - k) & (n - 1);
+				// A_k B_k = (Z_k^2 - conj(Z_j)^2) / 4i
+				const double pr = zr[k] * zr[k] - zi[k] * zi[k], pi = 2 * zr[k] * zi[k];
+				const double qr = zr[j] * zr[j] - zi[j] * zi[j], qi = -2 * zr[j] * zi[j];
+				cr[k] = (pi - qi) / 4;
+				ci[k] = -(pr - qr) / 4;
+			}
+			fftSplit(cr.data(), ci.data(), n, wr.data(), wi.data(), true);
+			for (size_t i = 0; i < nc; i++)
+				out[i] = (T)cr[i];
+		}
+	}
+
+	static constexpr uint32_t nttPrimes[3] = { 998244353, 167772161, 469762049 };
+
+	// Number-theoretic transform modulo one of nttPrimes, all of which have 3 as a primitive root. The prime is a
+	// template argument so every reduction compiles to a multiplication instead of a division.
+	template<uint32_t p>
+	static void ntt(uint32_t* x, const size_t n, const bool inverse) {
+		for (size_t i = 1, j = 0; i < n; i++) {
+			size_t bit = n >> 1;
+			for (; j & bit; bit >>= 1)
+				j ^= bit;
+			j ^= bit;
+			if (i < j) std::swap(x[i], x[j]);
+		}
+		std::vector<uint32_t> w(n / 2);
+		for (size_t len = 2; len <= n; len <<= 1) {
+			const uint64_t g = powMod(3, (p - 1) / len, p), root = inverse ? powMod(g, p - 2, p) : g;
+			const size_t half = len / 2;
+			w[0] = 1;
+			for (size_t k = 1; k < half; k++)
+				w[k] = (uint32_t)(w[k - 1] * root % p);
+			for (size_t s = 0; s < n; s += len)
+				for (size_t k = 0; k < half; k++) {
+					const uint32_t u = x[s + k], v = (uint32_t)(x[s + k + half] * (uint64_t)w[k] % p);
+					x[s + k] = u + v >= p ? u + v - p : u + v;
+					x[s + k + half] = u >= v ? u - v : u + p - v;
+				}
+		}
+		if (inverse) {
+			const uint64_t inv = powMod(n, p - 2, p);
+			for (size_t i = 0; i < n; i++)
+				x[i] = (uint32_t)(x[i] * inv % p);
+		}
+	}
+
+	// Cyclic convolution of x and y modulo p, left in x; both hold residues and have the same power-of-two length.
+	template<uint32_t p>
+	static void nttProduct(std::vector<uint32_t>& x, std::vector<uint32_t>& y) {
+		const size_t n = x.size();
+		ntt<p>(x.data(), n, false);
+		ntt<p>(y.data(), n, false);
+		for (size_t i = 0; i < n; i++)
+			x[i] = (uint32_t)((uint64_t)x[i] * y[i] % p);
+		ntt<p>(x.data(), n, true);
+	}
+
+	// Exact integer products through three NTT primes; the result is lifted into (-P/2, P/2) for signed types and
+	// reduced modulo 2^64 like the schoolbook loop would, so callers must only come here when |c| < P/2.
+	template<typename T>
+	static void nttMul(const T* a, const size_t na, const T* b, const size_t nb, T* out) {
+		const size_t nc = na + nb - 1;
+		size_t n = 1;
+		while (n < nc)
+			n <<= 1;
+		uint32_t res[3];
+		std::vector<uint32_t> r[3];
+		auto transform = [&]<uint32_t p>(std::vector<uint32_t>& dst) {
+			auto reduce = [](const T v) -> uint32_t {
+				if constexpr (std::is_signed_v<T>) {
+					const uint64_t m = (uint64_t)(v < 0 ? -(v + 1) : v) % p;
+					return (uint32_t)(v < 0 ? (p - 1 - m) % p : m);
+				}
+				else
+					return (uint32_t)((uint64_t)v % p);
+			};
+			std::vector<uint32_t> x(n), y(n);
+			for (size_t i = 0; i < na; i++)
+				x[i] = reduce(a[i]);
+			for (size_t i = 0; i < nb; i++)
+				y[i] = reduce(b[i]);
+			nttProduct<p>(x, y);
+			dst.swap(x);
+		};
+		transform.template operator()<nttPrimes[0]>(r[0]);
+		transform.template operator()<nttPrimes[1]>(r[1]);
+		transform.template operator()<nttPrimes[2]>(r[2]);
+		const uint64_t p1 = nttPrimes[0], p2 = nttPrimes[1], p3 = nttPrimes[2], p12 = p1 * p2;
+		const uint64_t i12 = powMod(p1, p2 - 2, p2), i123 = powMod(p12 % p3, p3 - 2, p3);
+		for (size_t i = 0; i < nc; i++) {
+			res[0] = r[0][i];
+			res[1] = r[1][i];
+			res[2] = r[2][i];
+			// Garner: x = r1 + p1 k2 + p1 p2 k3 with k2 < p2 and k3 < p3.
+			const uint64_t k2 = (res[1] + p2 - res[0] % p2) % p2 * i12 % p2;
+			const uint64_t low = res[0] + p1 * k2;
+			const uint64_t k3 = (res[2] + p3 - low % p3) % p3 * i123 % p3;
+			uint64_t v = low + p12 * k3;
+			if constexpr (std::is_signed_v<T>)
+				if (k3 > p3 / 2 || (k3 == p3 / 2 && low > p12 / 2)) v -= p12 * p3;
+			out[i] = (T)v;
+		}
+	}
+
+	// Products in modint<P>: one transform when P is itself an NTT prime, otherwise three transforms and Garner's
+	// reconstruction taken modulo P. Coefficients below 2^31 keep every convolution term under p1 p2 p3 up to 2^24 terms.
+	template<uint32_t P>
+	static void modNttMul(const modint<P>* a, const size_t na, const modint<P>* b, const size_t nb, modint<P>* out) {
+		const size_t nc = na + nb - 1;
+		size_t n = 1;
+		while (n < nc)
+			n <<= 1;
+		auto residues = [&](const modint<P>* x, const size_t nx) {
+			std::vector<uint32_t> r(n, 0);
+			for (size_t i = 0; i < nx; i++)
+				r[i] = x[i].value();
+			return r;
+		};
+		if constexpr (P == nttPrimes[0] || P == nttPrimes[1] || P == nttPrimes[2]) {
+			std::vector<uint32_t> x = residues(a, na), y = residues(b, nb);
+			nttProduct<P>(x, y);
+			for (size_t i = 0; i < nc; i++)
+				out[i] = modint<P>(x[i]);
+		}
+		else {
+			std::vector<uint32_t> r[3];
+			auto transform = [&]<uint32_t p>(std::vector<uint32_t>& dst) {
+				std::vector<uint32_t> x = residues(a, na), y = residues(b, nb);
+				for (auto& e : x) e %= p;
+				for (auto& e : y) e %= p;
+				nttProduct<p>(x, y);
+				dst.swap(x);
+			};
+			transform.template operator()<nttPrimes[0]>(r[0]);
+			transform.template operator()<nttPrimes[1]>(r[1]);
+			transform.template operator()<nttPrimes[2]>(r[2]);
+			const uint64_t p1 = nttPrimes[0], p2 = nttPrimes[1], p3 = nttPrimes[2], p12 = p1 * p2;
+			const uint64_t i12 = powMod(p1, p2 - 2, p2), i123 = powMod(p12 % p3, p3 - 2, p3);
+			for (size_t i = 0; i < nc; i++) {
+				const uint64_t k2 = (r[1][i] + p2 - r[0][i] % p2) % p2 * i12 % p2;
+				const uint64_t low = r[0][i] + p1 * k2;
+				const uint64_t k3 = (r[2][i] + p3 - low % p3) % p3 * i123 % p3;
+				out[i] = modint<P>(low % P) + modint<P>(p12 % P) * modint<P>(k3);
+			}
+		}
+	}
+
+	template<typename T>
+	static void polyMul(const T* a, const size_t na, const T* b, const size_t nb, T* out) {
+		const size_t small = std::min(na, nb);
+		if constexpr (isModint<T>::value) {
+			if (small >= modNttThreshold) {
+				modNttMul(a, na, b, nb, out);
+				return;
+			}
+		}
+		if (small < karatsubaThreshold) {
+			schoolbookMul(a, na, b, nb, out);
+			return;
+		}
+		if constexpr (std::is_floating_point_v<T> || (isComplex<T>::value && std::is_floating_point_v<typename cxType<T>::base>)) {
+			if (small >= fftThreshold) {
+				fftMul(a, na, b, nb, out);
+				return;
+			}
+		}
+		else if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t)) {
+			if (small >= nttThreshold) {
+				auto mag = [](const T* x, const size_t n) {
+					double m = 0;
+					for (size_t i = 0; i < n; i++)
+						m = std::max(m, std::is_signed_v<T> && x[i] < 0 ? -(double)x[i] : (double)x[i]);
+					return m;
+				};
+				// p1 p2 p3 is about 7.8e25; the margin covers rounding in the bound itself.
+				if (mag(a, na) * mag(b, nb) * (double)small < (std::is_signed_v<T> ? 3.8e25 : 7.6e25)) {
+					nttMul(a, na, b, nb, out);
+					return;
+				}
+			}
+		}
+		karatsubaMul(a, na, b, nb, out);
+	}
+
+	template<typename T>
+	static const std::vector<T> mulTrunc(const T* a, const size_t na, const T* b, const size_t nb, const size_t keep) {
+		const size_t la = std::min(na, keep), lb = std::min(nb, keep);
+		std::vector<T> res(la + lb - 1, T(0));
+		polyMul(a, la, b, lb, res.data());
+		res.resize(std::min(res.size(), keep));
+		return res;
+	}
+
+	// Power series inverse of f modulo x^m by Newton iteration, g <- g (2 - f g), doubling the precision each step.
+	template<typename T>
+	static const std::vector<T> seriesInverse(const T* f, const size_t nf, const size_t m) {
+		std::vector<T> g{ T(1) / f[0] };
+		for (size_t k = 1; k < m;) {
+			const size_t k2 = std::min(2 * k, m);
+			std::vector<T> e = mulTrunc(f, nf, g.data(), g.size(), k2);
+			e.resize(k2, T(0));
+			for (auto& c : e)
+				c = -c;
+			e[0] += T(2);
+			g = mulTrunc(g.data(), g.size(), e.data(), e.size(), k2);
+			k = k2;
+		}
+		g.resize(m, T(0));
+		return g;
+	}
+
+	// q receives na - nb + 1 coefficients and r receives nb - 1; b must have a non-zero leading coefficient.
+	template<typename T>
+	static void polyDivMod(const T* a, const size_t na, const T* b, const size_t nb, T* q, T* r) {
+		const size_t m = na - nb + 1;
+		// Only exact arithmetic: in floating point the truncated inverse amplifies the rounding error of every product.
+		if constexpr (exactField<T>::value) {
+			if (std::min(m, nb) >= newtonDivThreshold) {
+				// The reversed quotient is the reversed dividend times the inverse of the reversed divisor, modulo x^m.
+				std::vector<T> ra(a + na - m, a + na), rb(b, b + nb);
+				std::reverse(ra.begin(), ra.end());
+				std::reverse(rb.begin(), rb.end());
+				const std::vector<T> inv = seriesInverse(rb.data(), rb.size(), m);
+				std::vector<T> rq = mulTrunc(ra.data(), m, inv.data(), m, m);
+				rq.resize(m, T(0));
+				std::reverse_copy(rq.begin(), rq.end(), q);
+				const std::vector<T> bq = mulTrunc(b, nb, q, m, nb - 1);
+				for (size_t i = 0; i + 1 < nb; i++)
+					r[i] = a[i] - (i < bq.size() ? bq[i] : T(0));
+				return;
+			}
+		}
+		std::vector<T> rem(a, a + na);
+		const T lead = b[nb - 1];
+		for (size_t i = m; i-- > 0;) {
+			const T c = rem[i + nb - 1] / lead;
+			q[i] = c;
+			for (size_t j = 0; j + 1 < nb; j++)
+				rem[i + j] -= c * b[j];
+		}
+		std::copy(rem.begin(), rem.begin() + (nb - 1), r);
+	}
+
+	template<typename B>
+	static inline const B cxAbs(const complex<B>& z) {
+		return std::hypot(z.re, z.im);
+	}
+
+	// Value and first derivative by Horner's rule, with the running bound on the rounding error of the value.
+	template<typename B>
+	static inline void hornerDeriv(const complex<B>* c, const size_t n, const complex<B>& z, complex<B>& p, complex<B>& d, B& err) {
+		const B az = cxAbs(z);
+		p = c[n];
+		d = complex<B>(B(0), B(0));
+		err = cxAbs(c[n]) / 2;
+		for (size_t k = n; k-- > 0;) {
+			d = d * z + p;
+			p = p * z + c[k];
+			err = err * az + cxAbs(p);
+		}
+		err = (2 * err - cxAbs(p)) * std::numeric_limits<B>::epsilon();
+	}
+
+	// Newton correction p(z) / p'(z). Outside the unit disk the reversed polynomial q(w) = w^n p(1 / w) is evaluated
+	// instead, p / p' = z / (n - w q'(w) / q(w)), so high orders never overflow. Returns false once p(z) is below its
+	// rounding error bound.
+	template<typename B>
+	static const bool newtonRatio(const complex<B>* c, const size_t n, const complex<B>& z, complex<B>& ratio) {
+		using C = complex<B>;
+		const B az = cxAbs(z);
+		if (az <= B(1)) {
+			C p, d;
+			B err;
+			hornerDeriv(c, n, z, p, d, err);
+			if (cxAbs(p) <= err) return false;
+			ratio = p / d;
+			return true;
+		}
+		const C w = C(B(1), B(0)) / z;
+		const B aw = B(1) / az;
+		C q = c[0], d(B(0), B(0));
+		B err = cxAbs(c[0]) / 2;
+		for (size_t k = 1; k <= n; k++) {
+			d = d * w + q;
+			q = q * w + c[k];
+			err = err * aw + cxAbs(q);
+		}
+		err = (2 * err - cxAbs(q)) * std::numeric_limits<B>::epsilon();
+		if (cxAbs(q) <= err) return false;
+		ratio = z / (C((B)n, B(0)) - w * d / q);
+		return true;
+	}
+
+	template<typename B>
+	static void newtonPolish(const complex<B>* c, const size_t n, complex<B>& z) {
+		for (int it = 0; it < 3; it++) {
+			complex<B> p, d;
+			B err;
+			hornerDeriv(c, n, z, p, d, err);
+			if (cxAbs(p) <= err || cxAbs(d) == B(0)) return;
+			z -= p / d;
+		}
+	}
+
+	// Closed forms for orders 1 to 4 on the monic coefficients c; the callers polish the results with Newton steps.
+	template<typename B>
+	static void closedRoots(const complex<B>* c, const size_t n, std::vector<complex<B>>& res) {
+		using C = complex<B>;
+		auto quadratic = [](const C& b, const C& k, C& r1, C& r2) {
+			// Roots of x^2 + bx + k; the larger one avoids cancellation and the other follows from Vieta.
+			const C s = cxSqrt(b * b - k * B(4));
+			const C q = (b.re * s.re + b.im * s.im >= B(0)) ? (b + s) * B(-0.5) : (b - s) * B(-0.5);
+			r1 = q;
+			r2 = cxAbs(q) == B(0) ? C(B(0), B(0)) : k / q;
+		};
+		auto cubic = [](const C& a, const C& b, const C& k, C* r) {
+			// Cardano on the depressed cubic t^3 + pt + q with x = t - a/3.
+			const C p = b - a * a / B(3), q = a * a * a * B(2) / B(27) - a * b / B(3) + k;
+			const C disc = cxSqrt(q * q / B(4) + p * p * p / B(27));
+			C u = cxCbrt(q * B(-0.5) + disc);
+			if (cxAbs(u) == B(0)) u = cxCbrt(q * B(-0.5) - disc);
+			const C w(B(-0.5), std::sqrt(B(3)) / 2);
+			C uk = u;
+			for (int i = 0; i < 3; i++, uk = uk * w)
+				r[i] = (cxAbs(uk) == B(0) ? C(B(0), B(0)) : uk - p / (uk * B(3))) - a / B(3);
+		};
+		res.resize(n);
+		if (n == 1) res[0] = c[0] * B(-1);
+		else if (n == 2) quadratic(c[1], c[0], res[0], res[1]);
+		else if (n == 3) cubic(c[2], c[1], c[0], res.data());
+		else {
+			// Ferrari: depress to y^4 + py^2 + qy + r, pick a root m of the resolvent cubic and split into two quadratics.
+			const C a = c[3] / B(4);
+			const C p = c[2] - a * a * B(6), q = c[1] - c[2] * a * B(2) + a * a * a * B(8);
+			const C r = c[0] - c[1] * a + c[2] * a * a - a * a * a * a * B(3);
+			C m[3];
+			cubic(p, p * p / B(4) - r, q * q * B(-0.125), m);
+			C best = m[0];
+			for (int i = 1; i < 3; i++)
+				if (cxAbs(m[i]) > cxAbs(best)) best = m[i];
+			if (cxAbs(best) == B(0)) {
+				// Biquadratic: q vanishes, so y^2 solves z^2 + pz + r.
+				C z1, z2;
+				quadratic(p, r, z1, z2);
+				res[0] = cxSqrt(z1);
+				res[1] = res[0] * B(-1);
+				res[2] = cxSqrt(z2);
+				res[3] = res[2] * B(-1);
+			}
+			else {
+				const C s = cxSqrt(best * B(2)), t = q / (s * B(2));
+				quadratic(s, p / B(2) + best - t, res[0], res[1]);
+				quadratic(s * B(-1), p / B(2) + best + t, res[2], res[3]);
+			}
+			for (auto& z : res)
+				z -= a;
+		}
+	}
+
+	template<typename T, _MX_SIZE_T_ _N>
+	MATHPLUSPLUS_API constexpr fixedPolynom<T, _N>::fixedPolynom() : buf{} {}
+	template<typename T, _MX_SIZE_T_ _N>
+	template<typename U>
+	MATHPLUSPLUS_API constexpr fixedPolynom<T, _N>::fixedPolynom(const std::array<U, _N + 1>& buff) : buf{} {
+		for (_MX_SIZE_T_ i = 0; i <= _N; i++)
+			buf[i] = (T)buff[i];
+	}
+	template<typename T, _MX_SIZE_T_ _N>
+	template<typename U>
+	MATHPLUSPLUS_API constexpr fixedPolynom<T, _N>::fixedPolynom(const std::initializer_list<U>& buff) : buf{} {
+		_MX_SIZE_T_ i = 0;
+		for (auto c : buff)
+			if (i <= _N) buf[i++] = (T)c;
+	}
+
+	template<typename T, _MX_SIZE_T_ _N>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const _MX_SIZE_T_ fixedPolynom<T, _N>::order() {
+		return _N;
+	}
+
+	template<typename T, _MX_SIZE_T_ _N>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& fixedPolynom<T, _N>::operator[](const _MX_SIZE_T_& n) {
+		return buf[n];
+	}
+	template<typename T, _MX_SIZE_T_ _N>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& fixedPolynom<T, _N>::operator[](const _MX_SIZE_T_& n) const {
+		return buf[n];
+	}
+	template<typename T, _MX_SIZE_T_ _N>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto fixedPolynom<T, _N>::operator()(const U& x) const {
+		using V = std::remove_cv_t<decltype(T() * U())>;
+		return fixedHorner<V, _N>(buf.data(), x);
+	}
+
 	template<typename T>
 	MATHPLUSPLUS_API constexpr inline void polynom<T>::pop() {
-		while (buf[buf.size() - 1] == 0 && buf.size() > 1)
+		while (buf.size() > 1 && buf.back() == T(0))
 			buf.pop_back();
 	}
 	template<typename T>
@@ -59,9 +756,16 @@ namespace math {
 	}
 	template<typename T>
 	template<typename U>
+	MATHPLUSPLUS_API constexpr polynom<T>::polynom(const std::vector<U>& buff) {
+		buf.clear();
+		for (auto c : buff)
+			buf.push_back((T)c);
+	}
+	template<typename T>
+	template<typename U>
 	MATHPLUSPLUS_API constexpr polynom<T>::polynom(const polynom<U>& x) {
 		buf.clear();
-		for (_MX_SIZE_T_ i = 0; i < x.order(); i++)
+		for (_MX_SIZE_T_ i = 0; i <= x.order(); i++)
 			buf.push_back((T)x[i]);
 	}
 
@@ -70,49 +774,292 @@ namespace math {
 		return buf.size() - 1;
 	}
 	template<typename T>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const std::vector<typename cxType<T>::type> polynom<T>::solve() const {
-		polynom<T> x(*this);
-		x.pop();
-		if (x.order() == 0) return { };
-		using U = typename cxType<T>::type;
-		std::vector<U> res;
-		U r = pow(abs(x[0] / x[x.order()]), 1 / x.order());
-		U n1 = -cxPow((T)-1, 1 / (x.order() + 1)), n2 = -cxPow((T)-1, 1 / x.order());
-		for (_MX_SIZE_T_ i = 0; i <= x.order(); i++)
-			res.push_back(n1 * pow(n2, i));
-		std::vector<U> tmp;
-		bool flag = true;
-		while (flag) {
-			tmp = res;
-			for (_MX_SIZE_T_ i = 0; i <= x.order(); i++) {
-				U t = 1;
-				for (_MX_SIZE_T_ j = 0; j <= x.order(); j++)
-					if (i != j) t *= tmp[i] - tmp[j];
-				res[i] -= x(tmp[i]) / t;
+	template<typename B>
+	MATHPLUSPLUS_API [[nodiscard]] const std::vector<complex<B>> polynom<T>::solve(const rootOptions<B>& opt) const {
+		using C = complex<B>;
+		std::vector<C> res;
+		if (opt.squareFree && buf.size() > 2) {
+			rootOptions<B> sub = opt;
+			sub.squareFree = false;
+			const std::vector<polynom<T>> f = squareFreeFactors(*this);
+			for (size_t i = 0; i < f.size(); i++) {
+				if (f[i].order() == 0) continue;
+				const std::vector<C> z = f[i].template solve<B>(sub);
+				for (size_t k = 0; k <= i; k++)
+					res.insert(res.end(), z.begin(), z.end());
+			}
+			return res;
+		}
+		size_t lo = 0, hi = buf.size();
+		while (hi > 0 && buf[hi - 1] == T(0))
+			hi--;
+		// Vanishing low coefficients are roots at zero and are split off before iterating.
+		while (lo < hi && buf[lo] == T(0))
+			lo++;
+		if (hi <= lo + 1) {
+			res.assign(hi > 0 ? lo : 0, C(B(0), B(0)));
+			return res;
+		}
+		const size_t n = hi - lo - 1;
+		std::vector<C> c(n + 1);
+		for (size_t k = 0; k <= n; k++) {
+			if constexpr (isComplex<T>::value)
+				c[k] = C((B)buf[lo + k].re, (B)buf[lo + k].im);
+			else
+				c[k] = C((B)buf[lo + k], B(0));
+		}
+		const C lead = c[n];
+		for (auto& x : c)
+			x = x / lead;
+		std::vector<C> z;
+		if (n <= 4) {
+			closedRoots(c.data(), n, z);
+			for (auto& x : z)
+				newtonPolish(c.data(), n, x);
+		}
+		else {
+			// Start on a circle between the Cauchy lower and upper bounds, at the geometric mean of the root moduli.
+			B upper = 0, lower = 0;
+			for (size_t k = 0; k < n; k++)
+				upper = std::max(upper, cxAbs(c[k]));
+			const B a0 = cxAbs(c[0]);
+			for (size_t k = 1; k <= n; k++)
+				lower = std::max(lower, cxAbs(c[k]));
+			lower = a0 / (a0 + lower);
+			upper += 1;
+			const B radius = std::clamp(std::pow(a0, B(1) / (B)n), lower, upper);
+			z.resize(n);
+			for (size_t k = 0; k < n; k++) {
+				const B t = B(6.283185307179586476925) * (B)k / (B)n + B(0.4);
+				z[k] = C(radius * std::cos(t), radius * std::sin(t));
+			}
+			std::vector<C> step(n);
+			std::vector<char> done(n, 0);
+			for (size_t it = 0; it < opt.maxIter; it++) {
+				// Jacobi sweep: every correction reads the previous iterate, so roots update independently.
+				parallelFor(opt.pol, 0, n, std::max<size_t>(1, 4096 / n), [&](const size_t a, const size_t b) {
+					for (size_t i = a; i < b; i++) {
+						step[i] = C(B(0), B(0));
+						if (done[i]) continue;
+						C ratio;
+						if (!newtonRatio(c.data(), n, z[i], ratio)) {
+							done[i] = 1;
+							continue;
+						}
+						C s(B(0), B(0));
+						for (size_t j = 0; j < n; j++)
+							if (j != i) s += C(B(1), B(0)) / (z[i] - z[j]);
+						step[i] = ratio / (C(B(1), B(0)) - ratio * s);
+					}
+				});
+				bool all = true;
+				for (size_t i = 0; i < n; i++) {
+					if (done[i]) continue;
+					z[i] -= step[i];
+					if (cxAbs(step[i]) <= opt.tol * std::max(cxAbs(z[i]), B(1))) done[i] = 1;
+					else all = false;
+				}
+				if (all) break;
 			}
-			for (_MX_SIZE_T_ i = 0; i <= x.order(); i++)
-				flag &= (res[i] == tmp[i]);
-			flag = !flag;
 		}
+		res.assign(lo, C(B(0), B(0)));
+		res.insert(res.end(), z.begin(), z.end());
+		return res;
 	}
 
 	template<typename T>
 	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::horner(const U& x) const {
+		using V = std::remove_cv_t<decltype(T() * U())>;
+		if (buf.empty()) return V(0);
+		return hornerEval<V>(buf.data(), buf.size() - 1, x);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::estrin(const U& x) const {
+		using V = std::remove_cv_t<decltype(T() * U())>;
+		if (buf.empty()) return V(0);
+		const _MX_SIZE_T_ n = buf.size();
+		const V x2 = V(x) * V(x), x4 = x2 * x2, x8 = x4 * x4;
+		// Blocks of eight coefficients are independent, so their Estrin trees overlap in the pipeline; the blocks are chained with x^8.
+		const _MX_SIZE_T_ full = n / 8 * 8;
+		V res = full < n ? hornerEval<V>(buf.data() + full, n - full - 1, x) : V(0);
+		for (_MX_SIZE_T_ b = full; b > 0; b -= 8) {
+			const T* c = buf.data() + b - 8;
+			const V p01 = c[0] + c[1] * x, p23 = c[2] + c[3] * x, p45 = c[4] + c[5] * x, p67 = c[6] + c[7] * x;
+			res = res * x8 + ((p01 + p23 * x2) + (p45 + p67 * x2) * x4);
+		}
+		return res;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const std::pair<polynom<T>, polynom<T>> polynom<T>::divmod(const polynom<U>& x) const {
+		polynom<T> d(x), a(*this);
+		d.pop();
+		a.pop();
+		if (d.buf.empty() || d.buf.back() == T(0)) throw zero_divisor();
+		std::pair<polynom<T>, polynom<T>> res;
+		if (a.buf.size() < d.buf.size()) {
+			res.first.buf.assign(1, T(0));
+			res.second = a;
+			return res;
+		}
+		res.first.buf.assign(a.buf.size() - d.buf.size() + 1, T(0));
+		res.second.buf.assign(std::max<size_t>(d.buf.size() - 1, 1), T(0));
+		polyDivMod(a.buf.data(), a.buf.size(), d.buf.data(), d.buf.size(), res.first.buf.data(), res.second.buf.data());
+		res.first.pop();
+		res.second.pop();
+		return res;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void polynom<T>::derivative(polynom<T>& out) const {
+		const size_t n = buf.size();
+		if (n <= 1) {
+			out.buf.assign(1, T(0));
+			return;
+		}
+		// Ascending order reads buf[k] before it can be overwritten when out aliases *this.
+		if (out.buf.size() < n - 1) out.buf.resize(n - 1);
+		for (size_t k = 1; k < n; k++)
+			out.buf[k - 1] = buf[k] * T(k);
+		out.buf.resize(n - 1);
+		out.pop();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> polynom<T>::derivative() const {
+		polynom<T> res;
+		derivative(res);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API polynom<T>& polynom<T>::differentiate() {
+		derivative(*this);
+		return *this;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void polynom<T>::antiderivative(polynom<T>& out, const T& c) const {
+		// Integer coefficients divide with truncation, like operator/= on a scalar.
+		const size_t n = buf.size();
+		out.buf.resize(n + 1);
+		for (size_t k = n; k-- > 0;)
+			out.buf[k + 1] = buf[k] / T(k + 1);
+		out.buf[0] = c;
+		out.pop();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> polynom<T>::antiderivative(const T& c) const {
+		polynom<T> res;
+		antiderivative(res, c);
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API polynom<T>& polynom<T>::integrate(const T& c) {
+		antiderivative(*this, c);
+		return *this;
+	}
+
+	// p(q) for the n coefficients at p: Horner's rule on short ranges, otherwise p_lo(q) + q^h p_hi(q) with h = 2^k
+	// taken from pw[k] = q^(2^k), so the expensive products are few and large enough for the fast multiply.
+	template<typename T>
+	static void composeRange(const T* p, const size_t n, const std::vector<polynom<T>>& pw, polynom<T>& out) {
+		if (n <= composeThreshold) {
+			out = polynom<T>{ p[n - 1] };
+			for (size_t i = n - 1; i-- > 0;) {
+				out *= pw[0];
+				out += p[i];
+			}
+			return;
+		}
+		size_t k = 0;
+		while (((size_t)2 << k) < n) k++;
+		const size_t h = (size_t)1 << k;
+		polynom<T> hi;
+		composeRange(p + h, n - h, pw, hi);
+		hi *= pw[k];
+		composeRange(p, h, pw, out);
+		out += hi;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API void polynom<T>::compose(const polynom<U>& q, polynom<T>& out) const {
+		if (buf.empty()) {
+			out.buf.assign(1, T(0));
+			return;
+		}
+		std::vector<polynom<T>> pw{ polynom<T>(q) };
+		while (((size_t)1 << pw.size()) < buf.size())
+			pw.push_back(pw.back() * pw.back());
+		polynom<T> res;
+		composeRange(buf.data(), buf.size(), pw, res);
+		out.buf.swap(res.buf);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> polynom<T>::compose(const polynom<U>& q) const {
+		polynom<T> res;
+		compose(q, res);
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API polynom<T>& polynom<T>::substitute(const polynom<U>& q) {
+		compose(q, *this);
+		return *this;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void polynom<T>::evalN(std::span<const T> xs, std::span<T> out, const execution pol) const {
+		if (xs.size() != out.size()) throw length_mismatch();
+		if (buf.empty()) {
+			std::fill(out.begin(), out.end(), T(0));
+			return;
+		}
+		const size_t grain = std::max<size_t>(256, 65536 / buf.size());
+		parallelFor(pol, 0, xs.size(), grain, [&](const size_t lo, const size_t hi) {
+			if constexpr (isComplex<T>::value)
+				hornerPointsCx(buf.data(), buf.size() - 1, xs.data() + lo, out.data() + lo, hi - lo);
+			else
+				hornerPoints(buf.data(), buf.size() - 1, xs.data() + lo, out.data() + lo, hi - lo);
+		});
+	}
+	template<typename T>
+	template<typename C> requires (!std::is_same_v<C, T>)
+	MATHPLUSPLUS_API void polynom<T>::evalN(std::type_identity_t<std::span<const C>> xs, std::type_identity_t<std::span<C>> out, const execution pol) const {
+		if (xs.size() != out.size()) throw length_mismatch();
+		if (buf.empty()) {
+			std::fill(out.begin(), out.end(), C(0));
+			return;
+		}
+		const size_t grain = std::max<size_t>(256, 16384 / buf.size());
+		parallelFor(pol, 0, xs.size(), grain, [&](const size_t lo, const size_t hi) {
+			hornerPointsCx(buf.data(), buf.size() - 1, xs.data() + lo, out.data() + lo, hi - lo);
+		});
+	}
+
+	template<typename T>
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline T& polynom<T>::operator[](const _MX_SIZE_T_& n) {
 		return buf[n];
 	}
 
 	template<typename T>
-	template<typename U>
 	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T& polynom<T>::operator[](const _MX_SIZE_T_& n) const {
 		return buf[n];
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const T polynom<T>::operator()(const U& x) const {
-		T res = 0;
-		for (_MX_SIZE_T_ i = 0; i <= order(); i++)
-			res += buf[i] * pow(x, i);
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator()(const U& x) const {
+		using V = std::remove_cv_t<decltype(T() * U())>;
+		switch (buf.size()) {
+		case 0: return V(0);
+		case 1: return V(buf[0]);
+		case 2: return fixedHorner<V, 1>(buf.data(), x);
+		case 3: return fixedHorner<V, 2>(buf.data(), x);
+		case 4: return fixedHorner<V, 3>(buf.data(), x);
+		case 5: return fixedHorner<V, 4>(buf.data(), x);
+		default: return order() < estrinThreshold ? horner(x) : estrin(x);
+		}
 	}
 
 	template<typename T>
@@ -152,6 +1099,7 @@ namespace math {
 	template<typename T>
 	template<typename U>
 	MATHPLUSPLUS_API constexpr inline polynom<T>& polynom<T>::operator+=(const U& x) {
+		if (buf.empty()) buf.push_back(T(0));
 		buf[0] += x;
 		pop();
 		return *this;
@@ -159,7 +1107,7 @@ namespace math {
 	template<typename T>
 	template<typename U>
 	MATHPLUSPLUS_API constexpr inline polynom<T>& polynom<T>::operator+=(const polynom<U>& x) {
-		for (_MX_SIZE_T_ i = 0; i <= min(x.order(), order()); i++)
+		for (_MX_SIZE_T_ i = 0; i <= std::min<_MX_SIZE_T_>(x.order(), order()); i++)
 			buf[i] += x[i];
 		if (order() < x.order()) {
 			for (_MX_SIZE_T_ i = order() + 1; i <= x.order(); i++)
@@ -171,6 +1119,7 @@ namespace math {
 	template<typename T>
 	template<typename U>
 	MATHPLUSPLUS_API constexpr inline polynom<T>& polynom<T>::operator-=(const U& x) {
+		if (buf.empty()) buf.push_back(T(0));
 		buf[0] -= x;
 		pop();
 		return *this;
@@ -178,11 +1127,11 @@ namespace math {
 	template<typename T>
 	template<typename U>
 	MATHPLUSPLUS_API constexpr inline polynom<T>& polynom<T>::operator-=(const polynom<U>& x) {
-		for (_MX_SIZE_T_ i = 0; i <= min(x.order(), order()); i++)
+		for (_MX_SIZE_T_ i = 0; i <= std::min<_MX_SIZE_T_>(x.order(), order()); i++)
 			buf[i] -= x[i];
 		if (order() < x.order()) {
 			for (_MX_SIZE_T_ i = order() + 1; i <= x.order(); i++)
-				buf.push_back(-(T)x[i]);
+				buf.push_back(T(0) - (T)x[i]);
 		}
 		pop();
 		return *this;
@@ -198,14 +1147,16 @@ namespace math {
 	template<typename T>
 	template<typename U>
 	MATHPLUSPLUS_API constexpr inline polynom<T>& polynom<T>::operator*=(const polynom<U>& x) {
-		polynom<T> res;
-		for (_MX_SIZE_T_ i = 0; i <= x.order() + order(); i++) {
-			res.buf.push_back(0);
-			for (_MX_SIZE_T_ j = max(0, i - x.order()); j <= min(i, order()); j++)
-				res.buf[i] += buf[j] * x[i - j];
+		const polynom<T>& y = x;
+		if (buf.empty() || y.buf.empty()) {
+			buf.clear();
+			return *this;
 		}
-		res.pop();
-		return operator=(res);
+		std::vector<T> res(buf.size() + y.buf.size() - 1, T(0));
+		polyMul(buf.data(), buf.size(), y.buf.data(), y.buf.size(), res.data());
+		buf.swap(res);
+		pop();
+		return *this;
 	}
 	template<typename T>
 	template<typename U>
@@ -218,30 +1169,21 @@ namespace math {
 	template<typename T>
 	template<typename U>
 	MATHPLUSPLUS_API constexpr inline polynom<T>& polynom<T>::operator/=(const polynom<U>& x) {
-		polynom<T> tmp(*this), res;
-		res.buf.push_back(0);
-		for (_MX_SIZE_T_ i = x.order(); i <= order(); i++)
-			res.buf.push_back(0);
-		for (_MX_SIZE_T_ i = order() - x.order(); i >= 0; i--) {
-			res[i] = tmp[i + x.order()] / x[x.order() - 1];
-			for (_MX_SIZE_T_ j = 0; j < x.order(); j++)
-				tmp[order() - j] -= res[i] * x[x.order() - j];
-		}
-		res.pop();
-		return operator=(res);
+		std::pair<polynom<T>, polynom<T>> res = divmod(x);
+		buf.swap(res.first.buf);
+		return *this;
 	}
 	template<typename T>
 	template<typename U>
 	MATHPLUSPLUS_API constexpr inline polynom<T>& polynom<T>::operator%=(const polynom<U>& x) {
-		polynom<T> tmp(*this);
-		operator-=(tmp /= x);
-		pop();
+		std::pair<polynom<T>, polynom<T>> res = divmod(x);
+		buf.swap(res.second.buf);
 		return *this;
 	}
 
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator+(const U& x) const {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator+(const U& x) const& {
 		polynom<T> res(*this);
 		res += x;
 		res.pop();
@@ -249,7 +1191,13 @@ namespace math {
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator+(const polynom<U>& x) const {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator+(const U& x) && {
+		*this += x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator+(const polynom<U>& x) const& {
 		polynom<T> res(*this);
 		res += x;
 		res.pop();
@@ -257,7 +1205,13 @@ namespace math {
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator-(const U& x) const {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator+(const polynom<U>& x) && {
+		*this += x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator-(const U& x) const& {
 		polynom<T> res(*this);
 		res -= x;
 		res.pop();
@@ -265,7 +1219,13 @@ namespace math {
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator-(const polynom<U>& x) const {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator-(const U& x) && {
+		*this -= x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator-(const polynom<U>& x) const& {
 		polynom<T> res(*this);
 		res -= x;
 		res.pop();
@@ -273,7 +1233,13 @@ namespace math {
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator*(const U& x) const {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator-(const polynom<U>& x) && {
+		*this -= x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator*(const U& x) const& {
 		polynom<T> res(*this);
 		res *= x;
 		res.pop();
@@ -281,15 +1247,31 @@ namespace math {
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator*(const polynom<U>& x) const {
-		polynom<T> res(*this);
-		res *= x;
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator*(const U& x) && {
+		*this *= x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator*(const polynom<U>& x) const& {
+		// The product is built straight into the result, so p * q allocates once rather than copying p first.
+		const polynom<T>& y = x;
+		polynom<T> res;
+		if (buf.empty() || y.buf.empty()) return res;
+		res.buf.assign(buf.size() + y.buf.size() - 1, T(0));
+		polyMul(buf.data(), buf.size(), y.buf.data(), y.buf.size(), res.buf.data());
 		res.pop();
 		return res;
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator/(const U& x) const {
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator*(const polynom<U>& x) && {
+		*this *= x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator/(const U& x) const& {
 		polynom<T> res(*this);
 		res /= x;
 		res.pop();
@@ -297,18 +1279,981 @@ namespace math {
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator/(const polynom<U>& x) const {
-		polynom<T> res(*this);
-		res /= x;
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator/(const U& x) && {
+		*this /= x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator/(const polynom<U>& x) const& {
+		polynom<T> res = std::move(divmod(x).first);
 		res.pop();
 		return res;
 	}
 	template<typename T>
 	template<typename U>
-	MATHPLUSPLUS_API [[nodiscard]] constexpr inline const auto polynom<T>::operator%(const polynom<U>& x) const {
-		polynom<T> res(*this);
-		res %= x;
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator/(const polynom<U>& x) && {
+		*this /= x;
+		return std::move(*this);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator%(const polynom<U>& x) const& {
+		polynom<T> res = std::move(divmod(x).second);
 		res.pop();
 		return res;
 	}
-}
\ No newline at end of file
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] constexpr inline polynom<T> polynom<T>::operator%(const polynom<U>& x) && {
+		*this %= x;
+		return std::move(*this);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API subproductTree<T>::subproductTree(const std::vector<T>& points, const execution pol) : pts(points) {
+		if (pts.empty()) return;
+		levels.emplace_back(pts.size());
+		for (size_t i = 0; i < pts.size(); i++)
+			levels[0][i] = polynom<T>{ T(0) - pts[i], T(1) };
+		while (levels.back().size() > 1) {
+			const std::vector<polynom<T>>& below = levels.back();
+			std::vector<polynom<T>> above((below.size() + 1) / 2);
+			parallelFor(pol, 0, above.size(), 1, [&](const size_t lo, const size_t hi) {
+				for (size_t k = lo; k < hi; k++)
+					above[k] = 2 * k + 1 < below.size() ? below[2 * k] * below[2 * k + 1] : below[2 * k];
+			});
+			levels.push_back(std::move(above));
+		}
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t subproductTree<T>::size() const {
+		return pts.size();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<T>& subproductTree<T>::points() const {
+		return pts;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const polynom<T> subproductTree<T>::root() const {
+		return levels.empty() ? polynom<T>{ T(1) } : levels.back()[0];
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const std::vector<T> subproductTree<T>::evaluate(const polynom<U>& p, const execution pol) const {
+		std::vector<T> res(pts.size());
+		if (pts.empty()) return res;
+		if constexpr (std::is_floating_point_v<typename cxType<T>::base>) {
+			// Remainders by the large subproducts are ill-conditioned in floating point, so each point gets Horner's rule.
+			parallelFor(pol, 0, pts.size(), std::max<size_t>(1, 4096 / (p.order() + 1)), [&](const size_t lo, const size_t hi) {
+				for (size_t i = lo; i < hi; i++)
+					res[i] = p(pts[i]);
+			});
+			return res;
+		}
+		// Remainders shrink down the tree; once a node covers few points they are finished off with Horner's rule.
+		constexpr size_t leaf = 4;
+		size_t top = levels.size() - 1;
+		std::vector<polynom<T>> rem{ polynom<T>(p) % levels[top][0] };
+		for (; top > leaf; top--) {
+			const std::vector<polynom<T>>& below = levels[top - 1];
+			std::vector<polynom<T>> next(below.size());
+			parallelFor(pol, 0, below.size(), 1, [&](const size_t lo, const size_t hi) {
+				for (size_t k = lo; k < hi; k++)
+					next[k] = rem[k / 2] % below[k];
+			});
+			rem.swap(next);
+		}
+		const size_t span = (size_t)1 << top;
+		parallelFor(pol, 0, rem.size(), 1, [&](const size_t lo, const size_t hi) {
+			for (size_t k = lo; k < hi; k++)
+				for (size_t i = k * span; i < std::min(pts.size(), (k + 1) * span); i++)
+					res[i] = rem[k](pts[i]);
+		});
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const polynom<T> subproductTree<T>::interpolate(const std::vector<T>& values, const execution pol) const {
+		if (values.size() != pts.size()) throw length_mismatch();
+		if (pts.empty()) return polynom<T>{ T(0) };
+		if constexpr (std::is_floating_point_v<typename cxType<T>::base>) {
+			// Newton divided differences over the points in Leja order, expanded into coefficients by nested
+			// multiplication with (x - x_k). This is O(n^2), but the residuals stay orders of magnitude below those
+			// of the Lagrange weights from the tree; Leja order keeps the differences from cancelling.
+			const size_t n = pts.size();
+			const auto mag = [](const T& z) {
+				if constexpr (isComplex<T>::value) return cxAbs(z);
+				else return std::abs(z);
+			};
+			std::vector<T> x(pts), c(values), a(n, T(0));
+			// Log distances, since the products over thousands of points would underflow.
+			std::vector<decltype(mag(x[0]))> dist(n, 0);
+			for (size_t k = 0; k < n; k++) {
+				size_t best = k;
+				for (size_t i = k; i < n; i++) {
+					if (k > 0) dist[i] += std::log(mag(x[i] - x[k - 1]));
+					if (k == 0 ? mag(x[i]) > mag(x[best]) : dist[i] > dist[best]) best = i;
+				}
+				std::swap(x[k], x[best]);
+				std::swap(c[k], c[best]);
+				std::swap(dist[k], dist[best]);
+			}
+			for (size_t j = 1; j < n; j++)
+				for (size_t i = n - 1; i >= j; i--)
+					c[i] = (c[i] - c[i - 1]) / (x[i] - x[i - j]);
+			a[0] = c[n - 1];
+			for (size_t k = n - 1, d = 0; k-- > 0; d++) {
+				for (size_t i = d + 1; i > 0; i--)
+					a[i] = a[i - 1] - x[k] * a[i];
+				a[0] = c[k] - x[k] * a[0];
+			}
+			polynom<T> res(a);
+			res.pop();
+			return res;
+		}
+		// Lagrange weights y_i / M'(x_i) are combined upwards as P = P_left M_right + P_right M_left.
+		const polynom<T> m = root();
+		std::vector<T> dm(m.order());
+		for (size_t k = 1; k <= m.order(); k++)
+			dm[k - 1] = m[k] * T(k);
+		const std::vector<T> w = evaluate(polynom<T>(dm), pol);
+		std::vector<polynom<T>> cur(pts.size());
+		for (size_t i = 0; i < pts.size(); i++)
+			cur[i] = polynom<T>{ values[i] / w[i] };
+		for (size_t l = 0; l + 1 < levels.size(); l++) {
+			const std::vector<polynom<T>>& f = levels[l];
+			std::vector<polynom<T>> next((cur.size() + 1) / 2);
+			parallelFor(pol, 0, next.size(), 1, [&](const size_t lo, const size_t hi) {
+				for (size_t k = lo; k < hi; k++)
+					next[k] = 2 * k + 1 < cur.size() ? cur[2 * k] * f[2 * k + 1] + cur[2 * k + 1] * f[2 * k] : cur[2 * k];
+			});
+			cur.swap(next);
+		}
+		return cur[0];
+	}
+
+	template<typename V, typename U>
+	static inline const V powBySquaring(U x, uint64_t n) {
+		V res(1), b(x);
+		while (n) {
+			if (n & 1) res *= b;
+			n >>= 1;
+			if (n) b *= b;
+		}
+		return res;
+	}
+
+	template<typename T>
+	void sparse_polynom<T>::compact() {
+		std::sort(buf.begin(), buf.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		size_t k = 0;
+		for (size_t i = 0; i < buf.size(); i++) {
+			if (k > 0 && buf[k - 1].first == buf[i].first) buf[k - 1].second += buf[i].second;
+			else {
+				if (k > 0 && buf[k - 1].second == T(0)) k--;
+				buf[k++] = buf[i];
+			}
+		}
+		if (k > 0 && buf[k - 1].second == T(0)) k--;
+		buf.resize(k);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API sparse_polynom<T>::sparse_polynom() {}
+	template<typename T>
+	MATHPLUSPLUS_API sparse_polynom<T>::sparse_polynom(const std::initializer_list<std::pair<uint64_t, T>>& terms) : buf(terms) {
+		compact();
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>::sparse_polynom(const std::vector<std::pair<uint64_t, U>>& terms) {
+		buf.reserve(terms.size());
+		for (const auto& t : terms)
+			buf.emplace_back(t.first, (T)t.second);
+		compact();
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>::sparse_polynom(const polynom<U>& x) {
+		for (_MX_SIZE_T_ i = 0; i <= x.order(); i++)
+			if (x[i] != U(0)) buf.emplace_back(i, (T)x[i]);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>::sparse_polynom(const sparse_polynom<U>& x) {
+		buf.reserve(x.size());
+		for (const auto& t : x.terms())
+			if ((T)t.second != T(0)) buf.emplace_back(t.first, (T)t.second);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const uint64_t sparse_polynom<T>::order() const {
+		return buf.empty() ? 0 : buf.back().first;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t sparse_polynom<T>::size() const {
+		return buf.size();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<std::pair<uint64_t, T>>& sparse_polynom<T>::terms() const {
+		return buf;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const T sparse_polynom<T>::at(const uint64_t e) const {
+		const auto it = std::lower_bound(buf.begin(), buf.end(), e, [](const auto& t, const uint64_t v) { return t.first < v; });
+		return it != buf.end() && it->first == e ? it->second : T(0);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>& sparse_polynom<T>::insert(const uint64_t e, const U& x) {
+		const auto it = std::lower_bound(buf.begin(), buf.end(), e, [](const auto& t, const uint64_t v) { return t.first < v; });
+		if (it != buf.end() && it->first == e) {
+			it->second += x;
+			if (it->second == T(0)) buf.erase(it);
+		}
+		else if ((T)x != T(0)) buf.emplace(it, e, (T)x);
+		return *this;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const polynom<T> sparse_polynom<T>::toDense() const {
+		if (order() >= (uint64_t)std::numeric_limits<_MX_SIZE_T_>::max() || order() >= std::vector<T>().max_size()) throw order_overflow();
+		std::vector<T> res(buf.empty() ? 1 : order() + 1, T(0));
+		for (const auto& t : buf)
+			res[t.first] = t.second;
+		return polynom<T>(res);
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto sparse_polynom<T>::operator()(const U& x) const {
+		// Each gap between consecutive exponents costs O(log gap) multiplications.
+		using V = std::remove_cv_t<decltype(T() * U())>;
+		V res(0), p(1);
+		uint64_t e = 0;
+		for (const auto& t : buf) {
+			p *= powBySquaring<V>(x, t.first - e);
+			e = t.first;
+			res += p * t.second;
+		}
+		return res;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool sparse_polynom<T>::operator==(const sparse_polynom<U>& x) const {
+		if (size() != x.size()) return false;
+		for (size_t i = 0; i < size(); i++)
+			if (buf[i].first != x.terms()[i].first || buf[i].second != x.terms()[i].second) return false;
+		return true;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool sparse_polynom<T>::operator!=(const sparse_polynom<U>& x) const {
+		return !(*this == x);
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>& sparse_polynom<T>::operator+=(const sparse_polynom<U>& x) {
+		std::vector<std::pair<uint64_t, T>> res;
+		res.reserve(buf.size() + x.size());
+		size_t i = 0, j = 0;
+		const auto& y = x.terms();
+		while (i < buf.size() || j < y.size()) {
+			if (j == y.size() || (i < buf.size() && buf[i].first < y[j].first)) res.push_back(buf[i++]);
+			else if (i == buf.size() || y[j].first < buf[i].first) res.emplace_back(y[j].first, (T)y[j].second), j++;
+			else {
+				const T c = buf[i].second + y[j].second;
+				if (c != T(0)) res.emplace_back(buf[i].first, c);
+				i++, j++;
+			}
+		}
+		buf.swap(res);
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>& sparse_polynom<T>::operator-=(const sparse_polynom<U>& x) {
+		sparse_polynom<T> y(x);
+		for (auto& t : y.buf)
+			t.second = T(0) - t.second;
+		return *this += y;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>& sparse_polynom<T>::operator*=(const U& x) {
+		for (auto& t : buf)
+			t.second *= x;
+		std::erase_if(buf, [](const auto& t) { return t.second == T(0); });
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>& sparse_polynom<T>::operator*=(const sparse_polynom<U>& x) {
+		const sparse_polynom<T> y(x);
+		if (buf.empty() || y.buf.empty()) {
+			buf.clear();
+			return *this;
+		}
+		// The product's top exponent is the largest, so checking it covers every sum formed below.
+		if (order() > std::numeric_limits<uint64_t>::max() - y.order()) throw exponent_overflow();
+		const size_t n = std::min(buf.size(), y.buf.size()), m = std::max(buf.size(), y.buf.size());
+		const uint64_t top = order() + y.order();
+		// Products that would fill most of their dense range are cheaper through the fast dense multiply.
+		if (top < n * m && top < (uint64_t)std::numeric_limits<_MX_SIZE_T_>::max() - 1) {
+			const uint64_t len = top + 1;
+			std::vector<T> a(order() + 1, T(0)), b(y.order() + 1, T(0)), c(len, T(0));
+			for (const auto& t : buf) a[t.first] = t.second;
+			for (const auto& t : y.buf) b[t.first] = t.second;
+			polyMul(a.data(), a.size(), b.data(), b.size(), c.data());
+			buf.clear();
+			for (uint64_t e = 0; e < len; e++)
+				if (c[e] != T(0)) buf.emplace_back(e, c[e]);
+			return *this;
+		}
+		// Johnson's heap merge: one cursor per term of the shorter factor walks the longer one, so the
+		// products leave the heap in exponent order and like terms are summed as they appear.
+		const std::vector<std::pair<uint64_t, T>>& a = buf.size() <= y.buf.size() ? buf : y.buf;
+		const std::vector<std::pair<uint64_t, T>>& b = buf.size() <= y.buf.size() ? y.buf : buf;
+		using entry = std::pair<uint64_t, std::pair<uint32_t, uint32_t>>;
+		std::vector<entry> heap;
+		heap.reserve(n);
+		for (uint32_t i = 0; i < n; i++)
+			heap.push_back({ a[i].first + b[0].first, { i, 0 } });
+		const auto cmp = [](const entry& l, const entry& r) { return l.first > r.first; };
+		std::vector<std::pair<uint64_t, T>> res;
+		res.reserve(n + m);
+		while (!heap.empty()) {
+			std::pop_heap(heap.begin(), heap.end(), cmp);
+			const auto [e, ij] = heap.back();
+			const T c = a[ij.first].second * b[ij.second].second;
+			if (!res.empty() && res.back().first == e) res.back().second += c;
+			else {
+				if (!res.empty() && res.back().second == T(0)) res.pop_back();
+				res.emplace_back(e, c);
+			}
+			if (ij.second + 1 < m) {
+				heap.back() = { a[ij.first].first + b[ij.second + 1].first, { ij.first, ij.second + 1 } };
+				std::push_heap(heap.begin(), heap.end(), cmp);
+			}
+			else heap.pop_back();
+		}
+		if (!res.empty() && res.back().second == T(0)) res.pop_back();
+		buf.swap(res);
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_polynom<T>& sparse_polynom<T>::operator/=(const U& x) {
+		for (auto& t : buf)
+			t.second /= x;
+		std::erase_if(buf, [](const auto& t) { return t.second == T(0); });
+		return *this;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> sparse_polynom<T>::operator+(const sparse_polynom<U>& x) const {
+		sparse_polynom<T> res(*this);
+		return res += x;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> sparse_polynom<T>::operator-(const sparse_polynom<U>& x) const {
+		sparse_polynom<T> res(*this);
+		return res -= x;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> sparse_polynom<T>::operator*(const U& x) const {
+		sparse_polynom<T> res(*this);
+		return res *= x;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> sparse_polynom<T>::operator*(const sparse_polynom<U>& x) const {
+		sparse_polynom<T> res(*this);
+		return res *= x;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_polynom<T> sparse_polynom<T>::operator/(const U& x) const {
+		sparse_polynom<T> res(*this);
+		return res /= x;
+	}
+
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API mpolynom<T, _V>::mpolynom() {}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API mpolynom<T, _V>::mpolynom(const std::initializer_list<std::pair<monomial, T>>& terms) {
+		for (const auto& t : terms)
+			insert(t.first, t.second);
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API mpolynom<T, _V>::mpolynom(const mpolynom<U, _V>& x) {
+		for (const auto& t : x.terms(monomialOrder::lex))
+			insert(t.first, (T)t.second);
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> mpolynom<T, _V>::var(const _MX_SIZE_T_ i) {
+		monomial m{};
+		m[i] = 1;
+		return mpolynom<T, _V>{ { m, T(1) } };
+	}
+
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] inline const uint64_t mpolynom<T, _V>::pack(const monomial& m) {
+		uint64_t k = 0;
+		for (_MX_SIZE_T_ i = 0; i < _V; i++) {
+			if (m[i] > maxExponent) throw exponent_overflow();
+			k = _V == 1 ? m[i] : (k << bits) | m[i];
+		}
+		return k;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] inline const typename mpolynom<T, _V>::monomial mpolynom<T, _V>::unpack(uint64_t k) {
+		monomial m;
+		for (_MX_SIZE_T_ i = _V; i-- > 0;) {
+			m[i] = (uint32_t)(k & maxExponent);
+			if constexpr (_V > 1) k >>= bits;
+		}
+		return m;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] const bool mpolynom<T, _V>::less(const monomial& a, const monomial& b, const monomialOrder ord) {
+		if (ord != monomialOrder::lex) {
+			uint64_t da = 0, db = 0;
+			for (_MX_SIZE_T_ i = 0; i < _V; i++)
+				da += a[i], db += b[i];
+			if (da != db) return da < db;
+		}
+		if (ord == monomialOrder::grevlex) {
+			for (_MX_SIZE_T_ i = _V; i-- > 0;)
+				if (a[i] != b[i]) return a[i] > b[i];
+			return false;
+		}
+		return a < b;
+	}
+
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t mpolynom<T, _V>::size() const {
+		return buf.size();
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] const uint64_t mpolynom<T, _V>::order() const {
+		uint64_t res = 0;
+		for (const auto& t : buf) {
+			const monomial m = unpack(t.first);
+			uint64_t d = 0;
+			for (_MX_SIZE_T_ i = 0; i < _V; i++)
+				d += m[i];
+			res = std::max(res, d);
+		}
+		return res;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] const uint64_t mpolynom<T, _V>::order(const _MX_SIZE_T_ i) const {
+		uint64_t res = 0;
+		for (const auto& t : buf)
+			res = std::max<uint64_t>(res, unpack(t.first)[i]);
+		return res;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] const T mpolynom<T, _V>::at(const monomial& m) const {
+		const auto it = buf.find(pack(m));
+		return it == buf.end() ? T(0) : it->second;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API mpolynom<T, _V>& mpolynom<T, _V>::insert(const monomial& m, const U& x) {
+		const auto [it, added] = buf.try_emplace(pack(m), T(0));
+		it->second += x;
+		if (it->second == T(0)) buf.erase(it);
+		return *this;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] const std::vector<std::pair<typename mpolynom<T, _V>::monomial, T>> mpolynom<T, _V>::terms(const monomialOrder ord) const {
+		std::vector<std::pair<monomial, T>> res;
+		res.reserve(buf.size());
+		for (const auto& t : buf)
+			res.emplace_back(unpack(t.first), t.second);
+		std::sort(res.begin(), res.end(), [ord](const auto& a, const auto& b) { return less(b.first, a.first, ord); });
+		return res;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	MATHPLUSPLUS_API [[nodiscard]] const std::pair<typename mpolynom<T, _V>::monomial, T> mpolynom<T, _V>::leading(const monomialOrder ord) const {
+		std::pair<monomial, T> res{ monomial{}, T(0) };
+		bool first = true;
+		for (const auto& t : buf) {
+			const monomial m = unpack(t.first);
+			if (first || less(res.first, m, ord)) res = { m, t.second };
+			first = false;
+		}
+		return res;
+	}
+
+	// Terms in [t, t + n) are sorted by descending packed key and share the exponents of x0 .. x(v-1), so grouping
+	// them by the exponent of xv gives a sparse Horner scheme in xv whose coefficients recurse into the later variables.
+	template<typename V, typename T, typename U, _MX_SIZE_T_ _V>
+	static const V nestedHorner(const std::pair<uint64_t, T>* t, const size_t n, const std::array<U, _V>& x, const _MX_SIZE_T_ v) {
+		if (v == _V) return V(t[0].second);
+		constexpr unsigned bits = mpolynom<T, _V>::bits;
+		const unsigned shift = bits * (unsigned)(_V - 1 - v);
+		const auto field = [&](const uint64_t k) { return (k >> shift) & mpolynom<T, _V>::maxExponent; };
+		V res(0);
+		uint64_t prev = field(t[0].first);
+		for (size_t i = 0; i < n;) {
+			const uint64_t e = field(t[i].first);
+			size_t j = i;
+			while (j < n && field(t[j].first) == e) j++;
+			res = res * powBySquaring<V>(x[v], prev - e) + nestedHorner<V, T, U, _V>(t + i, j - i, x, v + 1);
+			prev = e;
+			i = j;
+		}
+		return res * powBySquaring<V>(x[v], prev);
+	}
+
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto mpolynom<T, _V>::operator()(const std::array<U, _V>& x) const {
+		using V = std::remove_cv_t<decltype(T() * U())>;
+		if (buf.empty()) return V(0);
+		std::vector<std::pair<uint64_t, T>> t(buf.begin(), buf.end());
+		std::sort(t.begin(), t.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+		return nestedHorner<V, T, U, _V>(t.data(), t.size(), x, 0);
+	}
+
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool mpolynom<T, _V>::operator==(const mpolynom<U, _V>& x) const {
+		if (size() != x.size()) return false;
+		for (const auto& t : buf)
+			if (x.at(unpack(t.first)) != t.second) return false;
+		return true;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const bool mpolynom<T, _V>::operator!=(const mpolynom<U, _V>& x) const {
+		return !(*this == x);
+	}
+
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API mpolynom<T, _V>& mpolynom<T, _V>::operator+=(const mpolynom<U, _V>& x) {
+		for (const auto& t : x.terms(monomialOrder::lex))
+			insert(t.first, t.second);
+		return *this;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API mpolynom<T, _V>& mpolynom<T, _V>::operator-=(const mpolynom<U, _V>& x) {
+		for (const auto& t : x.terms(monomialOrder::lex))
+			insert(t.first, T(0) - (T)t.second);
+		return *this;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API mpolynom<T, _V>& mpolynom<T, _V>::operator*=(const U& x) {
+		for (auto& t : buf)
+			t.second *= x;
+		std::erase_if(buf, [](const auto& t) { return t.second == T(0); });
+		return *this;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API mpolynom<T, _V>& mpolynom<T, _V>::operator*=(const mpolynom<U, _V>& x) {
+		const mpolynom<T, _V> y(x);
+		if (buf.empty() || y.buf.empty()) {
+			buf.clear();
+			return *this;
+		}
+		// Packed keys only add correctly while no field carries into its neighbour.
+		std::array<uint64_t, _V> radix;
+		uint64_t len = 1;
+		bool dense = true;
+		for (_MX_SIZE_T_ i = 0; i < _V; i++) {
+			radix[i] = order(i) + y.order(i) + 1;
+			if (radix[i] - 1 > maxExponent) throw exponent_overflow();
+			dense = dense && len <= ((uint64_t)1 << 40) / radix[i];
+			len *= dense ? radix[i] : 1;
+		}
+		const size_t n = buf.size(), m = y.buf.size();
+		// Kronecker substitution: when the product fills a good part of its bounding box, map every monomial to
+		// a mixed-radix index and let the univariate fast multiply do the work.
+		if (dense && len <= 4 * (uint64_t)n * m && len < (uint64_t)std::numeric_limits<_MX_SIZE_T_>::max()) {
+			std::array<uint64_t, _V> stride;
+			stride[_V - 1] = 1;
+			for (_MX_SIZE_T_ i = _V - 1; i-- > 0;)
+				stride[i] = stride[i + 1] * radix[i + 1];
+			const auto index = [&](const uint64_t k) {
+				const monomial e = unpack(k);
+				uint64_t r = 0;
+				for (_MX_SIZE_T_ i = 0; i < _V; i++)
+					r += e[i] * stride[i];
+				return r;
+			};
+			uint64_t na = 0, nb = 0;
+			for (const auto& t : buf) na = std::max(na, index(t.first) + 1);
+			for (const auto& t : y.buf) nb = std::max(nb, index(t.first) + 1);
+			std::vector<T> a(na, T(0)), b(nb, T(0)), c(na + nb - 1, T(0));
+			for (const auto& t : buf) a[index(t.first)] = t.second;
+			for (const auto& t : y.buf) b[index(t.first)] = t.second;
+			polyMul(a.data(), a.size(), b.data(), b.size(), c.data());
+			buf.clear();
+			for (uint64_t r = 0; r < c.size(); r++) {
+				if (c[r] == T(0)) continue;
+				uint64_t k = 0, q = r;
+				for (_MX_SIZE_T_ i = 0; i < _V; i++) {
+					k = _V == 1 ? q / stride[i] : (k << bits) | (q / stride[i]);
+					q %= stride[i];
+				}
+				buf.emplace(k, c[r]);
+			}
+			return *this;
+		}
+		std::unordered_map<uint64_t, T> res;
+		res.reserve(std::min<size_t>(n * m, (size_t)1 << 24));
+		for (const auto& a : buf)
+			for (const auto& b : y.buf)
+				res[a.first + b.first] += a.second * b.second;
+		std::erase_if(res, [](const auto& t) { return t.second == T(0); });
+		buf.swap(res);
+		return *this;
+	}
+
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> mpolynom<T, _V>::operator+(const mpolynom<U, _V>& x) const {
+		mpolynom<T, _V> res(*this);
+		return res += x;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> mpolynom<T, _V>::operator-(const mpolynom<U, _V>& x) const {
+		mpolynom<T, _V> res(*this);
+		return res -= x;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> mpolynom<T, _V>::operator*(const U& x) const {
+		mpolynom<T, _V> res(*this);
+		return res *= x;
+	}
+	template<typename T, _MX_SIZE_T_ _V>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const mpolynom<T, _V> mpolynom<T, _V>::operator*(const mpolynom<U, _V>& x) const {
+		mpolynom<T, _V> res(*this);
+		return res *= x;
+	}
+
+	// Degree with the zero polynomial at -1; polynom itself stores zero as the constant 0.
+	template<typename T>
+	static inline const ptrdiff_t degOf(const polynom<T>& p) {
+		return p.order() == 0 && p[0] == T(0) ? -1 : (ptrdiff_t)p.order();
+	}
+	// Drops the k lowest coefficients, i.e. the quotient by x^k.
+	template<typename T>
+	static const polynom<T> shiftDown(const polynom<T>& p, const size_t k) {
+		if (degOf(p) < (ptrdiff_t)k) return polynom<T>{ T(0) };
+		std::vector<T> c(p.order() + 1 - k);
+		for (size_t i = 0; i < c.size(); i++)
+			c[i] = p[(_MX_SIZE_T_)(i + k)];
+		return polynom<T>(c);
+	}
+	template<typename T>
+	static inline const rootBase<T> coefAbs(const T& x) {
+		if constexpr (isComplex<T>::value)
+			return cxAbs(x);
+		else
+			return std::abs((rootBase<T>)x);
+	}
+
+	// Transform [m0 m1; m2 m3] taking (a, b) to two consecutive remainders (c, d) of their Euclidean sequence with
+	// deg c >= ceil(deg a / 2) > deg d. Requires deg a > deg b.
+	template<typename T>
+	static const std::array<polynom<T>, 4> halfGcd(const polynom<T>& a, const polynom<T>& b) {
+		const ptrdiff_t n = degOf(a), m = (n + 1) / 2;
+		std::array<polynom<T>, 4> r{ polynom<T>{ T(1) }, polynom<T>{ T(0) }, polynom<T>{ T(0) }, polynom<T>{ T(1) } };
+		if (degOf(b) < m) return r;
+		if (n < (ptrdiff_t)halfGcdThreshold) {
+			polynom<T> c(a), d(b);
+			while (degOf(d) >= m) {
+				const auto [q, e] = c.divmod(d);
+				r = { r[2], r[3], r[0] - q * r[2], r[1] - q * r[3] };
+				c = std::move(d);
+				d = e;
+			}
+			return r;
+		}
+		r = halfGcd(shiftDown(a, m), shiftDown(b, m));
+		const polynom<T> c = r[0] * a + r[1] * b, d = r[2] * a + r[3] * b;
+		if (degOf(d) < m) return r;
+		const auto [q, e] = c.divmod(d);
+		r = { r[2], r[3], r[0] - q * r[2], r[1] - q * r[3] };
+		if (degOf(e) < m) return r;
+		const size_t k = (size_t)(2 * m - degOf(d));
+		const std::array<polynom<T>, 4> s = halfGcd(shiftDown(d, k), shiftDown(e, k));
+		return { s[0] * r[0] + s[1] * r[2], s[0] * r[1] + s[1] * r[3], s[2] * r[0] + s[3] * r[2], s[2] * r[1] + s[3] * r[3] };
+	}
+
+	template<typename T>
+	static const T content(const polynom<T>& p) {
+		T g(0);
+		for (_MX_SIZE_T_ i = 0; i <= p.order(); i++)
+			g = std::gcd(g, p[i]);
+		return g;
+	}
+	template<typename T>
+	static const polynom<T> primitivePart(const polynom<T>& p) {
+		const T g = content(p);
+		return g == T(0) ? p : p / g;
+	}
+	// lc(b)^(deg a - deg b + 1) a mod b, which stays in the integers.
+	template<typename T>
+	static const polynom<T> pseudoRem(const polynom<T>& a, const polynom<T>& b) {
+		const ptrdiff_t db = degOf(b);
+		std::vector<T> r(a.order() + 1);
+		for (size_t i = 0; i < r.size(); i++)
+			r[i] = a[(_MX_SIZE_T_)i];
+		const T lead = b[(_MX_SIZE_T_)db];
+		for (ptrdiff_t i = degOf(a); i >= db; i--) {
+			const T c = r[i];
+			for (auto& x : r)
+				x *= lead;
+			for (ptrdiff_t j = 0; j <= db; j++)
+				r[i - db + j] -= c * b[(_MX_SIZE_T_)j];
+		}
+		r.resize(std::max<ptrdiff_t>(db, 1));
+		polynom<T> res(r);
+		res.pop();
+		return res;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> gcd(const polynom<T>& x, const polynom<T>& y, const rootBase<T> tol) {
+		polynom<T> a(x), b(y);
+		a += T(0);
+		b += T(0);
+		if (degOf(a) < degOf(b)) std::swap(a, b);
+		if (degOf(b) < 0) {
+			if (degOf(a) < 0) return a;
+			if constexpr (std::is_integral_v<T>) {
+				a = primitivePart(a) * content(a);
+				return a[a.order()] < T(0) ? a * T(-1) : a;
+			}
+			else return a /= a[a.order()];
+		}
+		if constexpr (std::is_integral_v<T>) {
+			const T g = std::gcd(content(a), content(b));
+			a = primitivePart(a);
+			b = primitivePart(b);
+			while (degOf(b) >= 0) {
+				polynom<T> r = primitivePart(pseudoRem(a, b));
+				a = std::move(b);
+				b = std::move(r);
+			}
+			a = primitivePart(a) * g;
+			return a[a.order()] < T(0) ? a * T(-1) : a;
+		}
+		else if constexpr (exactField<T>::value) {
+			while (degOf(b) >= 0) {
+				if (degOf(b) >= (ptrdiff_t)halfGcdThreshold) {
+					const std::array<polynom<T>, 4> r = halfGcd(a, b);
+					polynom<T> c = r[0] * a + r[1] * b, d = r[2] * a + r[3] * b;
+					a = std::move(c);
+					b = std::move(d);
+					if (degOf(b) < 0) break;
+				}
+				polynom<T> r = a % b;
+				a = std::move(b);
+				b = std::move(r);
+			}
+			return a /= a[a.order()];
+		}
+		else {
+			static_assert(std::is_floating_point_v<rootBase<T>> && (std::is_floating_point_v<T> || isComplex<T>::value), "math::gcd needs integral, exact field, floating-point or complex coefficients");
+			const auto norm = [](const polynom<T>& p) {
+				rootBase<T> m(0);
+				for (_MX_SIZE_T_ i = 0; i <= p.order(); i++)
+					m = std::max(m, coefAbs(p[i]));
+				return m;
+			};
+			a = a / norm(a);
+			while (true) {
+				// b is measured against the unit-norm a it was divided out of; its leading noise is dropped first.
+				std::vector<T> c(b.order() + 1);
+				for (size_t i = 0; i < c.size(); i++)
+					c[i] = b[(_MX_SIZE_T_)i];
+				while (c.size() > 1 && coefAbs(c.back()) <= tol)
+					c.pop_back();
+				b = polynom<T>(c);
+				const rootBase<T> nb = norm(b);
+				if (nb <= tol) break;
+				b = b / nb;
+				if (b.order() == 0) return polynom<T>{ T(1) };
+				polynom<T> r = a % b;
+				a = std::move(b);
+				b = std::move(r);
+			}
+			return a /= a[a.order()];
+		}
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] std::vector<polynom<T>> squareFreeFactors(const polynom<T>& p, const rootBase<T> tol) {
+		std::vector<polynom<T>> res;
+		polynom<T> f(p);
+		f += T(0);
+		const ptrdiff_t n = degOf(f);
+		if (n < 1) return res;
+		const polynom<T> df = f.derivative();
+		polynom<T> a = gcd(f, df, tol);
+		polynom<T> b = f / a, d = df / a - b.derivative();
+		while (degOf(b) > 0 && (ptrdiff_t)res.size() < n) {
+			a = gcd(b, d, tol);
+			res.push_back(a);
+			polynom<T> c = d / a;
+			b = b / a;
+			d = std::move(c) - b.derivative();
+		}
+		if (degOf(b) > 0) res.push_back(b);
+		return res;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] T resultant(const polynom<T>& x, const polynom<T>& y) {
+		polynom<T> a(x), b(y);
+		a += T(0);
+		b += T(0);
+		if (degOf(a) < 0 || degOf(b) < 0) return T(0);
+		if constexpr (std::is_integral_v<T>) {
+			// Subresultant remainder sequence, which keeps every division exact (Cohen, Algorithm 3.3.7).
+			const T ca = content(a), cb = content(b);
+			const T t = powBySquaring<T>(ca, degOf(b)) * powBySquaring<T>(cb, degOf(a));
+			a = a / ca;
+			b = b / cb;
+			T s(1), g(1), h(1);
+			if (degOf(a) < degOf(b)) {
+				std::swap(a, b);
+				if (degOf(a) & degOf(b) & 1) s = -s;
+			}
+			if (degOf(b) == 0) return s * t * powBySquaring<T>(b[0], degOf(a));
+			while (degOf(b) > 0) {
+				const ptrdiff_t delta = degOf(a) - degOf(b);
+				if (degOf(a) & degOf(b) & 1) s = -s;
+				polynom<T> r = pseudoRem(a, b);
+				if (degOf(r) < 0) return T(0);
+				a = std::move(b);
+				b = r / (g * powBySquaring<T>(h, delta));
+				g = a[a.order()];
+				if (delta > 0) h = powBySquaring<T>(g, delta) / powBySquaring<T>(h, delta - 1);
+			}
+			const ptrdiff_t da = degOf(a);
+			h = powBySquaring<T>(b[0], da) / powBySquaring<T>(h, da - 1);
+			return s * t * h;
+		}
+		else {
+			// res(a, b) = (-1)^(deg a deg b) lc(b)^(deg a - deg r) res(b, r) with r = a mod b.
+			T res(1);
+			while (true) {
+				const ptrdiff_t n = degOf(a), m = degOf(b);
+				if (m == 0) return res * powBySquaring<T>(b[0], n);
+				polynom<T> r = a % b;
+				const ptrdiff_t d = degOf(r);
+				if (d < 0) return T(0);
+				if (n & m & 1) res = T(0) - res;
+				res = res * powBySquaring<T>(b[(_MX_SIZE_T_)m], n - d);
+				a = std::move(b);
+				b = std::move(r);
+			}
+		}
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] T discriminant(const polynom<T>& x) {
+		polynom<T> p(x);
+		p += T(0);
+		const ptrdiff_t n = degOf(p);
+		if (n < 1) return T(0);
+		if (n == 1) return T(1);
+		const T r = resultant(p, p.derivative()) / p[p.order()];
+		return (n * (n - 1) / 2) & 1 ? T(0) - r : r;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> powMod(const polynom<T>& base, uint64_t e, const polynom<T>& mod) {
+		polynom<T> m(mod);
+		m += T(0);
+		const ptrdiff_t d = degOf(m);
+		if (d < 0) throw zero_divisor();
+		if (d == 0) return polynom<T>{ T(0) };
+		if constexpr (!exactField<T>::value) {
+			// Reduction through a precomputed series inverse has the same instability as Newton division outside exact fields.
+			polynom<T> b = base % m, res = polynom<T>{ T(1) } % m;
+			for (; e; e >>= 1) {
+				if (e & 1) res = res * b % m;
+				if (e > 1) b = b * b % m;
+			}
+			return res;
+		}
+		std::vector<T> mc(d + 1), rm(d + 1);
+		for (ptrdiff_t i = 0; i <= d; i++)
+			mc[i] = rm[d - i] = m[(_MX_SIZE_T_)i];
+		// Products of two residues have order at most 2d - 2, so quotients never need more than d - 1 terms.
+		const size_t ql = std::max<ptrdiff_t>(d - 1, 1);
+		const std::vector<T> inv = seriesInverse(rm.data(), rm.size(), ql);
+		const auto reduce = [&](const polynom<T>& p) {
+			const ptrdiff_t dp = degOf(p);
+			if (dp < d) return p;
+			const size_t k = (size_t)(dp - d + 1);
+			std::vector<T> ra(k);
+			for (size_t i = 0; i < k; i++)
+				ra[i] = p[(_MX_SIZE_T_)(dp - i)];
+			std::vector<T> q = mulTrunc(ra.data(), k, inv.data(), inv.size(), k);
+			q.resize(k, T(0));
+			std::reverse(q.begin(), q.end());
+			const std::vector<T> mq = mulTrunc(mc.data(), mc.size(), q.data(), k, (size_t)d);
+			std::vector<T> r(d);
+			for (ptrdiff_t i = 0; i < d; i++)
+				r[i] = p[(_MX_SIZE_T_)i] - ((size_t)i < mq.size() ? mq[i] : T(0));
+			polynom<T> res(r);
+			res.pop();
+			return res;
+		};
+		polynom<T> b = degOf(base) <= 2 * d - 2 ? reduce(base + T(0)) : base % m;
+		polynom<T> res = reduce(polynom<T>{ T(1) });
+		for (; e; e >>= 1) {
+			if (e & 1) res = reduce(res * b);
+			if (e > 1) b = reduce(b * b);
+		}
+		return res;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] polynom<T> berlekampMassey(const std::vector<T>& s) {
+		std::vector<T> c{ T(1) }, b{ T(1) };
+		size_t l = 0, shift = 1;
+		T last(1);
+		for (size_t n = 0; n < s.size(); n++, shift++) {
+			T d = s[n];
+			for (size_t i = 1; i <= l; i++)
+				d += c[i] * s[n - i];
+			if (d == T(0)) continue;
+			const T coef = d / last;
+			const std::vector<T> prev = c;
+			if (c.size() < b.size() + shift) c.resize(b.size() + shift, T(0));
+			for (size_t i = 0; i < b.size(); i++)
+				c[i + shift] -= coef * b[i];
+			if (2 * l <= n) {
+				l = n + 1 - l;
+				b = prev;
+				last = d;
+				shift = 0;
+			}
+		}
+		c.resize(l + 1, T(0));
+		return polynom<T>(c);
+	}
+}
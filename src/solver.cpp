@@ -0,0 +1,417 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "solver.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace math {
+
+	MATHPLUSPLUS_API singular_preconditioner::singular_preconditioner() : std::runtime_error("Preconditioner cannot be built from a matrix with a zero or missing diagonal entry") {}
+
+	template<typename T, typename F>
+	MATHPLUSPLUS_API functionOperator<T, F>::functionOperator(const size_t n, F f) : n(n), f(std::move(f)) {}
+
+	template<typename T, typename F>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t functionOperator<T, F>::height() const {
+		return n;
+	}
+	template<typename T, typename F>
+	MATHPLUSPLUS_API void functionOperator<T, F>::apply(const std::vector<T>& x, std::vector<T>& y) const {
+		y.resize(n);
+		f(x, y);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void identityPreconditioner<T>::apply(const std::vector<T>& r, std::vector<T>& z) const {
+		z = r;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API jacobiPreconditioner<T>::jacobiPreconditioner(const dmatrix<U>& a) : inv(std::min(a.height(), a.width())) {
+		for (size_t i = 0; i < inv.size(); i++) {
+			if (a[i][i] == 0) throw singular_preconditioner();
+			inv[i] = T(1) / a[i][i];
+		}
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API jacobiPreconditioner<T>::jacobiPreconditioner(const sparse_matrix<U>& a) : inv(std::min(a.height(), a.width())) {
+		for (size_t i = 0; i < inv.size(); i++) {
+			const U d = a.at(i, i);
+			if (d == 0) throw singular_preconditioner();
+			inv[i] = T(1) / d;
+		}
+	}
+	template<typename T>
+	MATHPLUSPLUS_API void jacobiPreconditioner<T>::apply(const std::vector<T>& r, std::vector<T>& z) const {
+		z.resize(r.size());
+		for (size_t i = 0; i < r.size(); i++)
+			z[i] = inv[i] * r[i];
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API ilu0Preconditioner<T>::ilu0Preconditioner(const sparse_matrix<U>& a) {
+		sparse_matrix<T> tmp(a);
+		tmp.compress(sparseFormat::csr);
+		const size_t n = tmp.height();
+		row = tmp.outer();
+		col = tmp.inner();
+		val = tmp.values();
+		diag.assign(n, SIZE_MAX);
+		for (size_t i = 0; i < n; i++)
+			for (size_t p = row[i]; p < row[i + 1]; p++)
+				if (col[p] == i) diag[i] = p;
+		std::vector<size_t> pos(tmp.width(), SIZE_MAX);
+		for (size_t i = 0; i < n; i++) {
+			if (diag[i] == SIZE_MAX) throw singular_preconditioner();
+			for (size_t p = row[i]; p < row[i + 1]; p++)
+				pos[col[p]] = p;
+			for (size_t p = row[i]; p < row[i + 1] && col[p] < i; p++) {
+				const size_t k = col[p];
+				if (val[diag[k]] == 0) throw singular_preconditioner();
+				val[p] /= val[diag[k]];
+				for (size_t q = diag[k] + 1; q < row[k + 1]; q++)
+					if (pos[col[q]] != SIZE_MAX) val[pos[col[q]]] -= val[p] * val[q];
+			}
+			for (size_t p = row[i]; p < row[i + 1]; p++)
+				pos[col[p]] = SIZE_MAX;
+		}
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API ilu0Preconditioner<T>::ilu0Preconditioner(const dmatrix<U>& a) : ilu0Preconditioner(sparse_matrix<U>(a)) {}
+	template<typename T>
+	MATHPLUSPLUS_API void ilu0Preconditioner<T>::apply(const std::vector<T>& r, std::vector<T>& z) const {
+		const size_t n = diag.size();
+		z.resize(n);
+		for (size_t i = 0; i < n; i++) {
+			T s = r[i];
+			for (size_t p = row[i]; p < diag[i]; p++)
+				s -= val[p] * z[col[p]];
+			z[i] = s;
+		}
+		for (size_t i = n; i-- > 0;) {
+			T s = z[i];
+			for (size_t p = diag[i] + 1; p < row[i + 1]; p++)
+				s -= val[p] * z[col[p]];
+			z[i] = s / val[diag[i]];
+		}
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API luPreconditioner<T>::luPreconditioner(const dmatrix<U>& a, const execution pol) : perm(a.height()) {
+		if (a.height() != a.width()) throw non_square_matrix();
+		using V = typename accumType<T>::type;
+		const size_t n = a.height();
+		dmatrix<V> f(a);
+		for (size_t i = 0; i < n; i++)
+			perm[i] = i;
+		for (size_t k = 0; k < n; k++) {
+			size_t p = k;
+			for (size_t i = k + 1; i < n; i++)
+				if (std::abs(f(i, k)) > std::abs(f(p, k))) p = i;
+			if (f(p, k) == V(0)) throw singular_preconditioner();
+			if (p != k) {
+				std::swap_ranges(f[k], f[k] + n, f[p]);
+				std::swap(perm[k], perm[p]);
+			}
+			const V* pk = f[k];
+			parallelFor(pol, k + 1, n, std::max<size_t>(1, 16384 / (n - k)), [&](const size_t lo, const size_t hi) {
+				for (size_t i = lo; i < hi; i++) {
+					V* r = f[i];
+					const V l = r[k] /= pk[k];
+					for (size_t j = k + 1; j < n; j++)
+						r[j] -= l * pk[j];
+				}
+			});
+		}
+		lu = dmatrix<T>(f);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t luPreconditioner<T>::height() const {
+		return lu.height();
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API void luPreconditioner<T>::apply(const std::vector<U>& r, std::vector<U>& z) const {
+		using V = typename accumType<T>::type;
+		const size_t n = lu.height();
+		std::vector<V> y(n);
+		for (size_t i = 0; i < n; i++) {
+			V s = V(r[perm[i]]);
+			const T* row = lu[i];
+			for (size_t j = 0; j < i; j++)
+				s -= V(row[j]) * y[j];
+			y[i] = s;
+		}
+		for (size_t i = n; i-- > 0;) {
+			V s = y[i];
+			const T* row = lu[i];
+			for (size_t j = i + 1; j < n; j++)
+				s -= V(row[j]) * y[j];
+			y[i] = s / V(row[i]);
+		}
+		z.resize(n);
+		for (size_t i = 0; i < n; i++)
+			z[i] = U(y[i]);
+	}
+
+	template<typename A, typename T>
+	static inline void applyOp(const A& a, const std::vector<T>& x, std::vector<T>& y, const execution pol) {
+		if constexpr (requires { a.apply(x, y, pol); }) a.apply(x, y, pol);
+		else a.apply(x, y);
+	}
+	template<typename T>
+	static inline const T vecDot(const std::vector<T>& x, const std::vector<T>& y) {
+		T s = 0;
+		for (size_t i = 0; i < x.size(); i++)
+			s += x[i] * y[i];
+		return s;
+	}
+	template<typename T>
+	static inline const T vecNorm(const std::vector<T>& x) {
+		return std::sqrt(vecDot(x, x));
+	}
+	template<typename T>
+	static inline const T residual(const T& r, const T& b) {
+		return b > 0 ? r / b : r;
+	}
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> cg(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt) {
+		const size_t n = b.size();
+		x.resize(n, T(0));
+		std::vector<T> r(n), z(n), p(n), q(n);
+		applyOp(a, x, q, opt.pol);
+		for (size_t i = 0; i < n; i++)
+			r[i] = b[i] - q[i];
+		const T bn = vecNorm(b);
+		T res = residual(vecNorm(r), bn);
+		if (res <= opt.tol) return { 0, res, true };
+		m.apply(r, z);
+		p = z;
+		T rz = vecDot(r, z);
+		for (size_t it = 1; it <= opt.maxIter; it++) {
+			applyOp(a, p, q, opt.pol);
+			const T alpha = rz / vecDot(p, q);
+			for (size_t i = 0; i < n; i++) {
+				x[i] += alpha * p[i];
+				r[i] -= alpha * q[i];
+			}
+			res = residual(vecNorm(r), bn);
+			if (opt.trace) opt.trace(it, res);
+			if (res <= opt.tol) return { it, res, true };
+			m.apply(r, z);
+			const T rzn = vecDot(r, z), beta = rzn / rz;
+			rz = rzn;
+			for (size_t i = 0; i < n; i++)
+				p[i] = z[i] + beta * p[i];
+		}
+		return { opt.maxIter, res, false };
+	}
+	template<typename T, typename A> requires linearOperator<A, T>
+	MATHPLUSPLUS_API solverResult<T> cg(const A& a, const std::vector<T>& b, std::vector<T>& x, const solverOptions<T>& opt) {
+		return cg(a, b, x, identityPreconditioner<T>(), opt);
+	}
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> bicgstab(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt) {
+		const size_t n = b.size();
+		x.resize(n, T(0));
+		std::vector<T> r(n), rh(n), p(n, T(0)), v(n, T(0)), ph(n), s(n), sh(n), t(n);
+		applyOp(a, x, t, opt.pol);
+		for (size_t i = 0; i < n; i++)
+			r[i] = b[i] - t[i];
+		rh = r;
+		const T bn = vecNorm(b);
+		T res = residual(vecNorm(r), bn);
+		if (res <= opt.tol) return { 0, res, true };
+		T rho = 1, alpha = 1, omega = 1;
+		for (size_t it = 1; it <= opt.maxIter; it++) {
+			const T rhon = vecDot(rh, r);
+			if (rhon == 0) return { it, res, false };
+			const T beta = (rhon / rho) * (alpha / omega);
+			rho = rhon;
+			for (size_t i = 0; i < n; i++)
+				p[i] = r[i] + beta * (p[i] - omega * v[i]);
+			m.apply(p, ph);
+			applyOp(a, ph, v, opt.pol);
+			alpha = rho / vecDot(rh, v);
+			for (size_t i = 0; i < n; i++)
+				s[i] = r[i] - alpha * v[i];
+			res = residual(vecNorm(s), bn);
+			if (res <= opt.tol) {
+				for (size_t i = 0; i < n; i++)
+					x[i] += alpha * ph[i];
+				if (opt.trace) opt.trace(it, res);
+				return { it, res, true };
+			}
+			m.apply(s, sh);
+			applyOp(a, sh, t, opt.pol);
+			const T tt = vecDot(t, t);
+			omega = tt == 0 ? T(0) : vecDot(t, s) / tt;
+			for (size_t i = 0; i < n; i++) {
+				x[i] += alpha * ph[i] + omega * sh[i];
+				r[i] = s[i] - omega * t[i];
+			}
+			res = residual(vecNorm(r), bn);
+			if (opt.trace) opt.trace(it, res);
+			if (res <= opt.tol) return { it, res, true };
+			if (omega == 0) return { it, res, false };
+		}
+		return { opt.maxIter, res, false };
+	}
+	template<typename T, typename A> requires linearOperator<A, T>
+	MATHPLUSPLUS_API solverResult<T> bicgstab(const A& a, const std::vector<T>& b, std::vector<T>& x, const solverOptions<T>& opt) {
+		return bicgstab(a, b, x, identityPreconditioner<T>(), opt);
+	}
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> gmres(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt) {
+		const size_t n = b.size(), k = std::max<size_t>(1, std::min(opt.restart, n));
+		x.resize(n, T(0));
+		std::vector<std::vector<T>> v(k + 1, std::vector<T>(n));
+		std::vector<T> hs((k + 1) * k), cs(k), sn(k), g(k + 1), y(k), w(n), z(n);
+		auto hh = [&](const size_t i, const size_t j) -> T& { return hs[i * k + j]; };
+		const T bn = vecNorm(b);
+		T res = 0;
+		size_t it = 0;
+		while (true) {
+			applyOp(a, x, w, opt.pol);
+			for (size_t i = 0; i < n; i++)
+				v[0][i] = b[i] - w[i];
+			const T beta = vecNorm(v[0]);
+			res = residual(beta, bn);
+			if (res <= opt.tol) return { it, res, true };
+			if (it >= opt.maxIter) return { it, res, false };
+			for (size_t i = 0; i < n; i++)
+				v[0][i] /= beta;
+			std::fill(g.begin(), g.end(), T(0));
+			g[0] = beta;
+			size_t j = 0;
+			for (; j < k && it < opt.maxIter; j++) {
+				it++;
+				m.apply(v[j], z);
+				applyOp(a, z, w, opt.pol);
+				for (size_t i = 0; i <= j; i++) {
+					hh(i, j) = vecDot(w, v[i]);
+					for (size_t l = 0; l < n; l++)
+						w[l] -= hh(i, j) * v[i][l];
+				}
+				hh(j + 1, j) = vecNorm(w);
+				if (hh(j + 1, j) != 0)
+					for (size_t l = 0; l < n; l++)
+						v[j + 1][l] = w[l] / hh(j + 1, j);
+				for (size_t i = 0; i < j; i++) {
+					const T t = cs[i] * hh(i, j) + sn[i] * hh(i + 1, j);
+					hh(i + 1, j) = -sn[i] * hh(i, j) + cs[i] * hh(i + 1, j);
+					hh(i, j) = t;
+				}
+				const T d = std::hypot(hh(j, j), hh(j + 1, j));
+				cs[j] = d == 0 ? T(1) : hh(j, j) / d;
+				sn[j] = d == 0 ? T(0) : hh(j + 1, j) / d;
+				hh(j, j) = d;
+				hh(j + 1, j) = 0;
+				g[j + 1] = -sn[j] * g[j];
+				g[j] *= cs[j];
+				res = residual(std::abs(g[j + 1]), bn);
+				if (opt.trace) opt.trace(it, res);
+				if (res <= opt.tol || d == 0) {
+					j++;
+					break;
+				}
+			}
+			for (size_t i = j; i-- > 0;) {
+				T s = g[i];
+				for (size_t l = i + 1; l < j; l++)
+					s -= hh(i, l) * y[l];
+				y[i] = hh(i, i) == 0 ? T(0) : s / hh(i, i);
+			}
+			std::fill(w.begin(), w.end(), T(0));
+			for (size_t i = 0; i < j; i++)
+				for (size_t l = 0; l < n; l++)
+					w[l] += y[i] * v[i][l];
+			m.apply(w, z);
+			for (size_t l = 0; l < n; l++)
+				x[l] += z[l];
+		}
+	}
+	template<typename T, typename A> requires linearOperator<A, T>
+	MATHPLUSPLUS_API solverResult<T> gmres(const A& a, const std::vector<T>& b, std::vector<T>& x, const solverOptions<T>& opt) {
+		return gmres(a, b, x, identityPreconditioner<T>(), opt);
+	}
+
+	template<typename T, typename A, typename M> requires linearOperator<A, T> && preconditioner<M, T>
+	MATHPLUSPLUS_API solverResult<T> refine(const A& a, const std::vector<T>& b, std::vector<T>& x, const M& m, const solverOptions<T>& opt) {
+		const size_t n = b.size();
+		x.resize(n, T(0));
+		std::vector<T> r(n), d(n), q(n);
+		const T bn = vecNorm(b);
+		T last = T(0);
+		for (size_t it = 0; it <= opt.maxIter; it++) {
+			applyOp(a, x, q, opt.pol);
+			for (size_t i = 0; i < n; i++)
+				r[i] = b[i] - q[i];
+			const T res = residual(vecNorm(r), bn);
+			if (opt.trace) opt.trace(it, res);
+			if (res <= opt.tol) return { it, res, true };
+			// A correction that no longer halves the residual means the factors are too coarse for the requested tolerance.
+			if (it > 0 && res > last / 2) return { it, res, false };
+			last = res;
+			m.apply(r, d);
+			for (size_t i = 0; i < n; i++)
+				x[i] += d[i];
+		}
+		return { opt.maxIter, last, false };
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_matrix<T> poisson2d(const size_t n) {
+		sparse_matrix<T> res(n * n, n * n);
+		res.reserve(5 * n * n);
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = 0; j < n; j++) {
+				const size_t k = i * n + j;
+				res.insert(k, k, T(4));
+				if (i > 0) res.insert(k, k - n, T(-1));
+				if (i + 1 < n) res.insert(k, k + n, T(-1));
+				if (j > 0) res.insert(k, k - 1, T(-1));
+				if (j + 1 < n) res.insert(k, k + 1, T(-1));
+			}
+		return res.compress(sparseFormat::csr);
+	}
+}
@@ -0,0 +1,368 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "sparse.h"
+
+#include <numeric>
+#include <algorithm>
+
+namespace math {
+
+	MATHPLUSPLUS_API sparse_format_error::sparse_format_error() : std::runtime_error("Operation is not supported in the current math::sparse_matrix format") {}
+
+	template<typename T>
+	MATHPLUSPLUS_API sparse_matrix<T>::sparse_matrix() : h(0), w(0), fmt(sparseFormat::coo) {}
+	template<typename T>
+	MATHPLUSPLUS_API sparse_matrix<T>::sparse_matrix(const size_t h, const size_t w) : h(h), w(w), fmt(sparseFormat::coo) {}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_matrix<T>::sparse_matrix(const dmatrix<U>& x, const sparseFormat f) : h(x.height()), w(x.width()), fmt(sparseFormat::csr) {
+		outr.assign(h + 1, 0);
+		for (size_t i = 0; i < h; i++) {
+			const U* r = x[i];
+			for (size_t j = 0; j < w; j++)
+				if (r[j] != 0) {
+					innr.push_back(j);
+					val.push_back(r[j]);
+				}
+			outr[i + 1] = innr.size();
+		}
+		compress(f);
+	}
+	template<typename T>
+	template<typename U, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API sparse_matrix<T>::sparse_matrix(const matrix<U, _H, _W, _L>& x, const sparseFormat f) : h(_H), w(_W), fmt(sparseFormat::csr) {
+		outr.assign(h + 1, 0);
+		for (size_t i = 0; i < h; i++) {
+			for (size_t j = 0; j < w; j++)
+				if (x(i, j) != 0) {
+					innr.push_back(j);
+					val.push_back(x(i, j));
+				}
+			outr[i + 1] = innr.size();
+		}
+		compress(f);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_matrix<T>::sparse_matrix(const sparse_matrix<U>& x) : h(x.height()), w(x.width()), fmt(x.format()), outr(x.outer()), innr(x.inner()), val(x.values().begin(), x.values().end()) {}
+	template<typename T>
+	MATHPLUSPLUS_API sparse_matrix<T>::sparse_matrix(const size_t h, const size_t w, const sparseFormat f, std::vector<size_t>&& outer, std::vector<size_t>&& inner, std::vector<T>&& values) : h(h), w(w), fmt(f), outr(std::move(outer)), innr(std::move(inner)), val(std::move(values)) {
+		const size_t n = f == sparseFormat::coo ? val.size() : (f == sparseFormat::csr ? h : w) + 1;
+		if (outr.size() != n || innr.size() != val.size()) throw sparse_format_error();
+		if (f != sparseFormat::coo && (outr.front() != 0 || outr.back() != val.size())) throw sparse_format_error();
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t sparse_matrix<T>::height() const {
+		return h;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t sparse_matrix<T>::width() const {
+		return w;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t sparse_matrix<T>::nnz() const {
+		return val.size();
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const sparseFormat sparse_matrix<T>::format() const {
+		return fmt;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<size_t>& sparse_matrix<T>::outer() const {
+		return outr;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<size_t>& sparse_matrix<T>::inner() const {
+		return innr;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const std::vector<T>& sparse_matrix<T>::values() const {
+		return val;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API void sparse_matrix<T>::reserve(const size_t n) {
+		if (fmt == sparseFormat::coo) outr.reserve(n);
+		innr.reserve(n);
+		val.reserve(n);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_matrix<T>& sparse_matrix<T>::insert(const size_t i, const size_t j, const U& x) {
+		if (fmt != sparseFormat::coo) throw sparse_format_error();
+		if (i >= h || j >= w) throw dimension_mismatch();
+		outr.push_back(i);
+		innr.push_back(j);
+		val.push_back(x);
+		return *this;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API sparse_matrix<T>& sparse_matrix<T>::compress(const sparseFormat f) {
+		if (fmt == f && f != sparseFormat::coo) return *this;
+		std::vector<size_t> r, c;
+		if (fmt == sparseFormat::coo) {
+			r.swap(outr);
+			c.swap(innr);
+		}
+		else {
+			const size_t n = fmt == sparseFormat::csr ? h : w;
+			std::vector<size_t>& major = fmt == sparseFormat::csr ? r : c;
+			major.resize(val.size());
+			for (size_t i = 0; i < n; i++)
+				std::fill(major.begin() + outr[i], major.begin() + outr[i + 1], i);
+			(fmt == sparseFormat::csr ? c : r).swap(innr);
+		}
+		if (f == sparseFormat::coo) {
+			outr.swap(r);
+			innr.swap(c);
+			fmt = f;
+			return *this;
+		}
+		const std::vector<size_t>& major = f == sparseFormat::csr ? r : c;
+		const std::vector<size_t>& minor = f == sparseFormat::csr ? c : r;
+		const size_t n = f == sparseFormat::csr ? h : w;
+		std::vector<size_t> start(n + 1, 0);
+		for (size_t k = 0; k < val.size(); k++)
+			start[major[k] + 1]++;
+		std::partial_sum(start.begin(), start.end(), start.begin());
+		std::vector<size_t> pos(start.begin(), start.end() - 1), ind(val.size());
+		std::vector<T> v(val.size());
+		for (size_t k = 0; k < val.size(); k++) {
+			const size_t p = pos[major[k]]++;
+			ind[p] = minor[k];
+			v[p] = val[k];
+		}
+		std::vector<size_t> perm;
+		innr.clear();
+		val.clear();
+		outr.assign(n + 1, 0);
+		for (size_t i = 0; i < n; i++) {
+			perm.resize(start[i + 1] - start[i]);
+			std::iota(perm.begin(), perm.end(), start[i]);
+			if (!std::is_sorted(ind.begin() + start[i], ind.begin() + start[i + 1]))
+				std::stable_sort(perm.begin(), perm.end(), [&](const size_t a, const size_t b) { return ind[a] < ind[b]; });
+			for (size_t k = 0; k < perm.size(); k++) {
+				if (k > 0 && ind[perm[k]] == ind[perm[k - 1]]) val.back() += v[perm[k]];
+				else {
+					innr.push_back(ind[perm[k]]);
+					val.push_back(v[perm[k]]);
+				}
+			}
+			size_t keep = outr[i];
+			for (size_t k = outr[i]; k < val.size(); k++)
+				if (val[k] != 0) {
+					innr[keep] = innr[k];
+					val[keep++] = val[k];
+				}
+			innr.resize(keep);
+			val.resize(keep);
+			outr[i + 1] = keep;
+		}
+		fmt = f;
+		return *this;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const T sparse_matrix<T>::at(const size_t i, const size_t j) const {
+		if (fmt == sparseFormat::coo) {
+			T res = 0;
+			for (size_t k = 0; k < val.size(); k++)
+				if (outr[k] == i && innr[k] == j) res += val[k];
+			return res;
+		}
+		const size_t o = fmt == sparseFormat::csr ? i : j, n = fmt == sparseFormat::csr ? j : i;
+		auto first = innr.begin() + outr[o], last = innr.begin() + outr[o + 1];
+		auto it = std::lower_bound(first, last, n);
+		return it != last && *it == n ? val[it - innr.begin()] : T(0);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const sparse_matrix<T> sparse_matrix<T>::trans() const {
+		sparse_matrix<T> res(*this);
+		std::swap(res.h, res.w);
+		if (fmt == sparseFormat::coo) res.outr.swap(res.innr);
+		else res.fmt = fmt == sparseFormat::csr ? sparseFormat::csc : sparseFormat::csr;
+		return res;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const transView<sparse_matrix<T>> sparse_matrix<T>::t() const {
+		return transView<sparse_matrix<T>>(*this);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<T> sparse_matrix<T>::toDense() const {
+		dmatrix<T> res(h, w);
+		if (fmt == sparseFormat::coo) {
+			for (size_t k = 0; k < val.size(); k++)
+				res[outr[k]][innr[k]] += val[k];
+			return res;
+		}
+		const size_t n = fmt == sparseFormat::csr ? h : w;
+		for (size_t o = 0; o < n; o++)
+			for (size_t k = outr[o]; k < outr[o + 1]; k++) {
+				if (fmt == sparseFormat::csr) res[o][innr[k]] = val[k];
+				else res[innr[k]][o] = val[k];
+			}
+		return res;
+	}
+	template<typename T>
+	template<_MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const matrix<T, _H, _W, _L> sparse_matrix<T>::toMatrix() const {
+		if (h != _H || w != _W) throw dimension_mismatch();
+		const dmatrix<T> d = toDense();
+		matrix<T, _H, _W, _L> res;
+		for (_MX_SIZE_T_ i = 0; i < _H; i++)
+			for (_MX_SIZE_T_ j = 0; j < _W; j++)
+				res(i, j) = d[i][j];
+		return res;
+	}
+
+	template<typename T>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void sparse_matrix<T>::apply(const std::vector<U>& x, std::vector<V>& y, const execution pol) const {
+		if (x.size() != w) throw dimension_mismatch();
+		y.resize(h);
+		switch (fmt) {
+		case sparseFormat::csr:
+			parallelFor(pol, 0, h, 256, [&](const size_t lo, const size_t hi) {
+				for (size_t i = lo; i < hi; i++) {
+					V s = 0;
+					for (size_t k = outr[i]; k < outr[i + 1]; k++)
+						s += val[k] * x[innr[k]];
+					y[i] = s;
+				}
+			});
+			break;
+		case sparseFormat::csc:
+			std::fill(y.begin(), y.end(), V(0));
+			for (size_t j = 0; j < w; j++)
+				for (size_t k = outr[j]; k < outr[j + 1]; k++)
+					y[innr[k]] += val[k] * x[j];
+			break;
+		default:
+			std::fill(y.begin(), y.end(), V(0));
+			for (size_t k = 0; k < val.size(); k++)
+				y[outr[k]] += val[k] * x[innr[k]];
+		}
+	}
+	template<typename T>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void sparse_matrix<T>::applyTrans(const std::vector<U>& x, std::vector<V>& y, const execution pol) const {
+		if (x.size() != h) throw dimension_mismatch();
+		y.resize(w);
+		switch (fmt) {
+		case sparseFormat::csc:
+			parallelFor(pol, 0, w, 256, [&](const size_t lo, const size_t hi) {
+				for (size_t j = lo; j < hi; j++) {
+					V s = 0;
+					for (size_t k = outr[j]; k < outr[j + 1]; k++)
+						s += val[k] * x[innr[k]];
+					y[j] = s;
+				}
+			});
+			break;
+		case sparseFormat::csr:
+			std::fill(y.begin(), y.end(), V(0));
+			for (size_t i = 0; i < h; i++)
+				for (size_t k = outr[i]; k < outr[i + 1]; k++)
+					y[innr[k]] += val[k] * x[i];
+			break;
+		default:
+			std::fill(y.begin(), y.end(), V(0));
+			for (size_t k = 0; k < val.size(); k++)
+				y[innr[k]] += val[k] * x[outr[k]];
+		}
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto sparse_matrix<T>::spmv(const std::vector<U>& x, const execution pol) const {
+		std::vector<decltype(T()* U())> res;
+		apply(x, res, pol);
+		return res;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto sparse_matrix<T>::spmm(const dmatrix<U>& x, const execution pol) const {
+		if (x.height() != w) throw dimension_mismatch();
+		using V = decltype(T()* U());
+		const size_t m = x.width();
+		dmatrix<V> res(h, m);
+		auto axpy = [m](V* out, const T& a, const U* in) {
+			for (size_t j = 0; j < m; j++)
+				out[j] += a * in[j];
+		};
+		switch (fmt) {
+		case sparseFormat::csr:
+			parallelFor(pol, 0, h, std::max<size_t>(1, 4096 / (m + 1)), [&](const size_t lo, const size_t hi) {
+				for (size_t i = lo; i < hi; i++)
+					for (size_t k = outr[i]; k < outr[i + 1]; k++)
+						axpy(res[i], val[k], x[innr[k]]);
+			});
+			break;
+		case sparseFormat::csc:
+			for (size_t j = 0; j < w; j++)
+				for (size_t k = outr[j]; k < outr[j + 1]; k++)
+					axpy(res[innr[k]], val[k], x[j]);
+			break;
+		default:
+			for (size_t k = 0; k < val.size(); k++)
+				axpy(res[outr[k]], val[k], x[innr[k]]);
+		}
+		return res;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_matrix<T>& sparse_matrix<T>::operator*=(const U& x) {
+		for (auto& e : val)
+			e *= x;
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API sparse_matrix<T>& sparse_matrix<T>::operator/=(const U& x) {
+		for (auto& e : val)
+			e /= x;
+		return *this;
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto sparse_matrix<T>::operator*(const std::vector<U>& x) const {
+		return spmv(x);
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto sparse_matrix<T>::operator*(const dmatrix<U>& x) const {
+		return spmm(x);
+	}
+}
@@ -0,0 +1,398 @@
+/*
+
+Copyright (c) 2024, Augustus Klein
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in
+	  the documentation and/or other materials provided with the distribution.
+	* Neither the name of the author nor the names of its
+	  contributors may be used to endorse or promote products derived
+	  from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "view.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace math {
+
+	static void checkView(const size_t h, const size_t w, const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep, const size_t cstep) {
+		if (r && (i + (r - 1) * rstep >= h)) throw dimension_mismatch();
+		if (c && (j + (c - 1) * cstep >= w)) throw dimension_mismatch();
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API matrixView<T>::matrixView(T* p, const size_t h, const size_t w, const size_t rs, const size_t cs) : p(p), h(h), w(w), rs(rs), cs(cs) {}
+	template<typename T>
+	template<typename U> requires (!std::is_same_v<U, T> && std::is_convertible_v<U*, T*>)
+	MATHPLUSPLUS_API matrixView<T>::matrixView(const matrixView<U>& x) : p(x.data()), h(x.height()), w(x.width()), rs(x.rowStride()), cs(x.colStride()) {}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t matrixView<T>::height() const {
+		return h;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t matrixView<T>::width() const {
+		return w;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t matrixView<T>::rowStride() const {
+		return rs;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline const size_t matrixView<T>::colStride() const {
+		return cs;
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline T* matrixView<T>::data() const {
+		return p;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrixView<T>::view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep, const size_t cstep) const {
+		checkView(h, w, i, j, r, c, rstep, cstep);
+		return matrixView<T>(p + i * rs + j * cs, r, c, rs * rstep, cs * cstep);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrixView<T>::row(const size_t i) const {
+		return view(i, 0, 1, w);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrixView<T>::col(const size_t j) const {
+		return view(0, j, h, 1);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrixView<T>::t() const {
+		return matrixView<T>(p, w, h, cs, rs);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const dmatrix<typename matrixView<T>::value_type> matrixView<T>::eval() const {
+		dmatrix<value_type> res(h, w);
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				res[i][j] = (*this)(i, j);
+		return res;
+	}
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrixView<T>::mul(const M& x, const execution pol) const {
+		if (w != x.height()) throw dimension_mismatch();
+		using V = decltype(value_type()* x(0, 0));
+		const size_t n = x.width();
+		dmatrix<V> res(h, n);
+		parallelFor(pol, 0, h, std::max<size_t>(1, 4096 / (w * n + 1)), [&](const size_t lo, const size_t hi) {
+			for (size_t i = lo; i < hi; i++) {
+				V* out = res[i];
+				for (size_t k = 0; k < w; k++) {
+					const V a = (*this)(i, k);
+					for (size_t j = 0; j < n; j++)
+						out[j] += a * x(k, j);
+				}
+			}
+		});
+		return res;
+	}
+	template<typename T>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void matrixView<T>::apply(const std::vector<U>& x, std::vector<V>& y, const execution pol) const {
+		if (x.size() != w) throw dimension_mismatch();
+		y.resize(h);
+		parallelFor(pol, 0, h, std::max<size_t>(1, 4096 / (w + 1)), [&](const size_t lo, const size_t hi) {
+			for (size_t i = lo; i < hi; i++) {
+				const T* r = p + i * rs;
+				V s = 0;
+				for (size_t j = 0; j < w; j++)
+					s += r[j * cs] * x[j];
+				y[i] = s;
+			}
+		});
+	}
+	template<typename T>
+	template<typename U, typename V>
+	MATHPLUSPLUS_API void matrixView<T>::applyTrans(const std::vector<U>& x, std::vector<V>& y, const execution pol) const {
+		t().apply(x, y, pol);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] inline T& matrixView<T>::operator()(const size_t& i, const size_t& j) const {
+		return p[i * rs + j * cs];
+	}
+
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API [[nodiscard]] const bool matrixView<T>::operator==(const M& x) const {
+		if (h != x.height() || w != x.width()) return false;
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				if ((*this)(i, j) != x(i, j)) return false;
+		return true;
+	}
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API [[nodiscard]] const bool matrixView<T>::operator!=(const M& x) const {
+		return !(*this == x);
+	}
+
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API [[nodiscard]] const bool matrixView<T>::overlaps(const M& x) const {
+		// Transposes are checked through the storage they read, which is where the aliasing happens.
+		if constexpr (requires { x.base(); }) return overlaps(x.base());
+		else if constexpr (requires { x.data(); &x(0, 0); }) {
+			if (!h || !w || !x.height() || !x.width()) return false;
+			const std::less<const void*> lt;
+			return lt(x.data(), &(*this)(h - 1, w - 1) + 1) && lt(p, &x(x.height() - 1, x.width() - 1) + 1);
+		}
+		else return false;
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API const matrixView<T>& matrixView<T>::operator=(const matrixView<T>& x) const {
+		return operator=<matrixView<T>>(x);
+	}
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API const matrixView<T>& matrixView<T>::operator=(const M& x) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		if (overlaps(x)) {
+			dmatrix<value_type> tmp(h, w);
+			tmp.view(0, 0, h, w) = x;
+			return operator=(tmp);
+		}
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				(*this)(i, j) = x(i, j);
+		return *this;
+	}
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API const matrixView<T>& matrixView<T>::operator+=(const M& x) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		if (overlaps(x)) {
+			dmatrix<value_type> tmp(h, w);
+			tmp.view(0, 0, h, w) = x;
+			return operator+=(tmp);
+		}
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				(*this)(i, j) += x(i, j);
+		return *this;
+	}
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API const matrixView<T>& matrixView<T>::operator-=(const M& x) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		if (overlaps(x)) {
+			dmatrix<value_type> tmp(h, w);
+			tmp.view(0, 0, h, w) = x;
+			return operator-=(tmp);
+		}
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				(*this)(i, j) -= x(i, j);
+		return *this;
+	}
+	template<typename T>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API const matrixView<T>& matrixView<T>::operator*=(const U& x) const {
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				(*this)(i, j) *= x;
+		return *this;
+	}
+	template<typename T>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API const matrixView<T>& matrixView<T>::operator/=(const U& x) const {
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				(*this)(i, j) /= x;
+		return *this;
+	}
+
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrixView<T>::operator+(const M& x) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		dmatrix<decltype(value_type() + x(0, 0))> res(h, w);
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				res[i][j] = (*this)(i, j) + x(i, j);
+		return res;
+	}
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrixView<T>::operator-(const M& x) const {
+		if (h != x.height() || w != x.width()) throw dimension_mismatch();
+		dmatrix<decltype(value_type() - x(0, 0))> res(h, w);
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				res[i][j] = (*this)(i, j) - x(i, j);
+		return res;
+	}
+	template<typename T>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrixView<T>::operator*(const U& x) const {
+		dmatrix<decltype(value_type()* U())> res(h, w);
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				res[i][j] = (*this)(i, j) * x;
+		return res;
+	}
+	template<typename T>
+	template<typename M> requires matrixLike<M>
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrixView<T>::operator*(const M& x) const {
+		return mul(x);
+	}
+	template<typename T>
+	template<typename U> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] const auto matrixView<T>::operator/(const U& x) const {
+		dmatrix<decltype(value_type() / U())> res(h, w);
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				res[i][j] = (*this)(i, j) / x;
+		return res;
+	}
+
+	template<typename U, typename T> requires (!isMatrixType<U>::value)
+	MATHPLUSPLUS_API [[nodiscard]] const auto operator*(const U& x, const matrixView<T>& m) {
+		dmatrix<decltype(U()* std::remove_const_t<T>())> res(m.height(), m.width());
+		for (size_t i = 0; i < m.height(); i++)
+			for (size_t j = 0; j < m.width(); j++)
+				res[i][j] = x * m(i, j);
+		return res;
+	}
+
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrix<T, _H, _W, _L>::view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep, const size_t cstep) {
+		checkView(_H, _W, i, j, r, c, rstep, cstep);
+		if constexpr (_L::column) return matrixView<T>(&at(i, j), r, c, rstep, stride * cstep);
+		else return matrixView<T>(&at(i, j), r, c, stride * rstep, cstep);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> matrix<T, _H, _W, _L>::view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep, const size_t cstep) const {
+		checkView(_H, _W, i, j, r, c, rstep, cstep);
+		if constexpr (_L::column) return matrixView<const T>(&at(i, j), r, c, rstep, stride * cstep);
+		else return matrixView<const T>(&at(i, j), r, c, stride * rstep, cstep);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrix<T, _H, _W, _L>::row(const size_t i) {
+		return view(i, 0, 1, _W);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> matrix<T, _H, _W, _L>::row(const size_t i) const {
+		return view(i, 0, 1, _W);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrix<T, _H, _W, _L>::col(const size_t j) {
+		return view(0, j, _H, 1);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> matrix<T, _H, _W, _L>::col(const size_t j) const {
+		return view(0, j, _H, 1);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<_MX_SIZE_T_ _R, _MX_SIZE_T_ _C>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> matrix<T, _H, _W, _L>::block(const size_t i, const size_t j) {
+		static_assert(_R <= _H && _C <= _W, "Block of math::matrix must fit inside the matrix.");
+		return view(i, j, _R, _C);
+	}
+	template<typename T, _MX_SIZE_T_ _H, _MX_SIZE_T_ _W, typename _L>
+	template<_MX_SIZE_T_ _R, _MX_SIZE_T_ _C>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> matrix<T, _H, _W, _L>::block(const size_t i, const size_t j) const {
+		static_assert(_R <= _H && _C <= _W, "Block of math::matrix must fit inside the matrix.");
+		return view(i, j, _R, _C);
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>::dmatrix(const matrixView<U>& x) : h(x.height()), w(x.width()), buf(x.height() * x.width()) {
+		for (size_t i = 0; i < h; i++)
+			for (size_t j = 0; j < w; j++)
+				buf[i * w + j] = x(i, j);
+	}
+
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator=(const matrixView<U>& x) {
+		dmatrix<T> tmp(x);
+		h = tmp.h;
+		w = tmp.w;
+		buf.swap(tmp.buf);
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator+=(const matrixView<U>& x) {
+		view(0, 0, h, w) += x;
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API dmatrix<T>& dmatrix<T>::operator-=(const matrixView<U>& x) {
+		view(0, 0, h, w) -= x;
+		return *this;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator+(const matrixView<U>& x) const {
+		return view(0, 0, h, w) + x;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator-(const matrixView<U>& x) const {
+		return view(0, 0, h, w) - x;
+	}
+	template<typename T>
+	template<typename U>
+	MATHPLUSPLUS_API [[nodiscard]] const auto dmatrix<T>::operator*(const matrixView<U>& x) const {
+		return view(0, 0, h, w).mul(x);
+	}
+
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> dmatrix<T>::view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep, const size_t cstep) {
+		checkView(h, w, i, j, r, c, rstep, cstep);
+		return matrixView<T>(buf.data() + i * w + j, r, c, w * rstep, cstep);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> dmatrix<T>::view(const size_t i, const size_t j, const size_t r, const size_t c, const size_t rstep, const size_t cstep) const {
+		checkView(h, w, i, j, r, c, rstep, cstep);
+		return matrixView<const T>(buf.data() + i * w + j, r, c, w * rstep, cstep);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> dmatrix<T>::row(const size_t i) {
+		return view(i, 0, 1, w);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> dmatrix<T>::row(const size_t i) const {
+		return view(i, 0, 1, w);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<T> dmatrix<T>::col(const size_t j) {
+		return view(0, j, h, 1);
+	}
+	template<typename T>
+	MATHPLUSPLUS_API [[nodiscard]] const matrixView<const T> dmatrix<T>::col(const size_t j) const {
+		return view(0, j, h, 1);
+	}
+}